@@ -122,6 +122,9 @@ private:
     template <class BT>
     class CreateHandler;
 
+    template <class>
+    friend class ColumnReader;
+
     template <class Condition>
     Timestamp minmax(size_t* result_index) const noexcept
     {
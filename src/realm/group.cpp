@@ -1437,49 +1437,58 @@ public:
         return true;
     }
 
-    bool set_int(size_t, size_t, int_fast64_t, _impl::Instruction, size_t) noexcept
+    bool set_int(size_t, size_t row_ndx, int_fast64_t, _impl::Instruction, size_t) noexcept
     {
-        return true; // No-op
+        modify_row(row_ndx);
+        return true;
     }
 
-    bool add_int(size_t, size_t, int_fast64_t) noexcept
+    bool add_int(size_t, size_t row_ndx, int_fast64_t) noexcept
     {
-        return true; // No-op
+        modify_row(row_ndx);
+        return true;
     }
 
-    bool set_bool(size_t, size_t, bool, _impl::Instruction) noexcept
+    bool set_bool(size_t, size_t row_ndx, bool, _impl::Instruction) noexcept
     {
-        return true; // No-op
+        modify_row(row_ndx);
+        return true;
     }
 
-    bool set_float(size_t, size_t, float, _impl::Instruction) noexcept
+    bool set_float(size_t, size_t row_ndx, float, _impl::Instruction) noexcept
     {
-        return true; // No-op
+        modify_row(row_ndx);
+        return true;
     }
 
-    bool set_double(size_t, size_t, double, _impl::Instruction) noexcept
+    bool set_double(size_t, size_t row_ndx, double, _impl::Instruction) noexcept
     {
-        return true; // No-op
+        modify_row(row_ndx);
+        return true;
     }
 
-    bool set_string(size_t, size_t, StringData, _impl::Instruction, size_t) noexcept
+    bool set_string(size_t, size_t row_ndx, StringData, _impl::Instruction, size_t) noexcept
     {
-        return true; // No-op
+        modify_row(row_ndx);
+        return true;
     }
 
-    bool set_binary(size_t, size_t, BinaryData, _impl::Instruction) noexcept
+    bool set_binary(size_t, size_t row_ndx, BinaryData, _impl::Instruction) noexcept
     {
-        return true; // No-op
+        modify_row(row_ndx);
+        return true;
     }
 
-    bool set_olddatetime(size_t, size_t, OldDateTime, _impl::Instruction) noexcept
+    bool set_olddatetime(size_t, size_t row_ndx, OldDateTime, _impl::Instruction) noexcept
     {
-        return true; // No-op
+        modify_row(row_ndx);
+        return true;
     }
 
-    bool set_timestamp(size_t, size_t, Timestamp, _impl::Instruction) noexcept
+    bool set_timestamp(size_t, size_t row_ndx, Timestamp, _impl::Instruction) noexcept
     {
-        return true; // No-op
+        modify_row(row_ndx);
+        return true;
     }
 
     bool set_table(size_t col_ndx, size_t row_ndx, _impl::Instruction) noexcept
@@ -1503,9 +1512,10 @@ public:
         return true;
     }
 
-    bool set_null(size_t, size_t, _impl::Instruction, size_t) noexcept
+    bool set_null(size_t, size_t row_ndx, _impl::Instruction, size_t) noexcept
     {
-        return true; // No-op
+        modify_row(row_ndx);
+        return true;
     }
 
     bool set_link(size_t col_ndx, size_t, size_t, size_t, _impl::Instruction) noexcept
@@ -1535,14 +1545,16 @@ public:
         return true;
     }
 
-    bool insert_substring(size_t, size_t, size_t, StringData)
+    bool insert_substring(size_t, size_t row_ndx, size_t, StringData)
     {
-        return true; // No-op
+        modify_row(row_ndx);
+        return true;
     }
 
-    bool erase_substring(size_t, size_t, size_t, size_t)
+    bool erase_substring(size_t, size_t row_ndx, size_t, size_t)
     {
-        return true; // No-op
+        modify_row(row_ndx);
+        return true;
     }
 
     bool optimize_table() noexcept
@@ -1772,6 +1784,15 @@ public:
     }
 
 private:
+    // Let table views know that the contents of the row changed, such that
+    // they can re-evaluate their query for it.
+    void modify_row(size_t row_ndx) noexcept
+    {
+        typedef _impl::TableFriend tf;
+        if (m_table)
+            tf::adj_acc_modify_row(*m_table, row_ndx);
+    }
+
     Group& m_group;
     TableRef m_table;
     DescriptorRef m_desc;
@@ -1907,6 +1928,13 @@ void Group::advance_transact(ref_type new_top_ref, size_t new_file_size, _impl::
 
     m_alloc.update_reader_view(new_file_size); // Throws
 
+    // Let table views record which rows are changed by the transaction logs
+    typedef _impl::TableFriend tf;
+    for (Table* table : m_table_accessors) {
+        if (table)
+            tf::begin_row_change_tracking(*table);
+    }
+
     bool schema_changed = false;
     _impl::TransactLogParser parser; // Throws
     TransactAdvancer advancer(*this, schema_changed);
@@ -1917,6 +1945,11 @@ void Group::advance_transact(ref_type new_top_ref, size_t new_file_size, _impl::
     attach(new_top_ref, create_group_when_missing); // Throws
     refresh_dirty_accessors();                      // Throws
 
+    for (Table* table : m_table_accessors) {
+        if (table)
+            tf::end_row_change_tracking(*table, schema_changed);
+    }
+
     if (schema_changed)
         send_schema_change_notification();
 }
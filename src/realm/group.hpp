@@ -36,6 +36,7 @@
 
 namespace realm {
 
+class QueryResultCache;
 class SharedGroup;
 namespace _impl {
 class GroupFriend;
@@ -605,6 +606,12 @@ private:
     std::shared_ptr<metrics::Metrics> m_metrics;
     size_t m_total_rows;
 
+    // Set by SharedGroup for the duration of a read transaction when it has a
+    // query result cache. m_query_cache_version is the version of the bound
+    // snapshot.
+    QueryResultCache* m_query_cache = nullptr;
+    uint_fast64_t m_query_cache_version = 0;
+
     struct shared_tag {
     };
     Group(shared_tag) noexcept;
@@ -1254,6 +1261,17 @@ public:
         return group.get_replication();
     }
 
+    static QueryResultCache* get_query_cache(const Group& group, uint_fast64_t& version) noexcept
+    {
+        version = group.m_query_cache_version;
+        return group.m_query_cache;
+    }
+
+    static std::shared_ptr<metrics::Metrics> get_metrics(const Group& group) noexcept
+    {
+        return group.get_metrics();
+    }
+
     static void set_replication(Group& group, Replication* repl) noexcept
     {
         group.set_replication(repl);
@@ -34,6 +34,7 @@
 #include <realm/group_shared.hpp>
 #include <realm/group_writer.hpp>
 #include <realm/link_view.hpp>
+#include <realm/query_cache.hpp>
 #include <realm/replication.hpp>
 #include <realm/impl/simulated_failure.hpp>
 #include <realm/disable_sync_to_disk.hpp>
@@ -779,6 +780,7 @@ void SharedGroup::do_open(const std::string& path, bool no_create_file, bool is_
         m_group.set_metrics(m_metrics);
     }
 #endif // REALM_METRICS
+    m_query_cache = options.query_cache;
 
     Replication::HistoryType openers_hist_type = Replication::hist_None;
     int openers_hist_schema_version = 0;
@@ -1537,6 +1539,10 @@ void SharedGroup::set_transact_stage(SharedGroup::TransactStage stage) noexcept
 #endif
 
     m_transact_stage = stage;
+
+    // Query results can only be shared while the snapshot is immutable
+    m_group.m_query_cache = (stage == transact_Reading ? m_query_cache.get() : nullptr);
+    m_group.m_query_cache_version = m_read_lock.m_version;
 }
 
 #ifdef REALM_ASYNC_DAEMON
@@ -1748,6 +1754,8 @@ void SharedGroup::release_read_lock(ReadLockInfo& read_lock) noexcept
     SharedInfo* r_info = m_reader_map.get_addr();
     const Ringbuffer::ReadCount& r = r_info->readers.get(read_lock.m_reader_idx);
     atomic_double_dec(r.count); // <-- most of the exec time spent here
+    if (m_query_cache)
+        m_query_cache->release_version(read_lock.m_version);
 }
 
 
@@ -1770,6 +1778,8 @@ void SharedGroup::grab_read_lock(ReadLockInfo& read_lock, VersionID version_id)
             read_lock.m_version = r.version;
             read_lock.m_top_ref = to_size_t(r.current_top);
             read_lock.m_file_size = to_size_t(r.filesize);
+            if (m_query_cache)
+                m_query_cache->retain_version(read_lock.m_version);
             return;
         }
     }
@@ -1804,6 +1814,8 @@ void SharedGroup::grab_read_lock(ReadLockInfo& read_lock, VersionID version_id)
         read_lock.m_version = r.version;
         read_lock.m_top_ref = to_size_t(r.current_top);
         read_lock.m_file_size = to_size_t(r.filesize);
+        if (m_query_cache)
+            m_query_cache->retain_version(read_lock.m_version);
         return;
     }
 }
@@ -593,6 +593,8 @@ private:
     std::shared_ptr<metrics::Metrics> m_metrics;
 #endif // REALM_METRICS
 
+    std::shared_ptr<QueryResultCache> m_query_cache;
+
     void do_open(const std::string& file, bool no_create, bool is_backend, const SharedGroupOptions options);
 
     // Ring buffer management
@@ -1100,6 +1102,7 @@ inline bool SharedGroup::do_advance_read(O* observer, VersionID version_id, _imp
     g.release();
     release_read_lock(m_read_lock);
     m_read_lock = new_read_lock;
+    m_group.m_query_cache_version = m_read_lock.m_version;
 
     return true; // _impl::History::update_early_from_top_ref() was called
 }
@@ -20,10 +20,13 @@
 #define REALM_GROUP_SHARED_OPTIONS_HPP
 
 #include <functional>
+#include <memory>
 #include <string>
 
 namespace realm {
 
+class QueryResultCache;
+
 struct SharedGroupOptions {
 
     /// The persistence level of the SharedGroup.
@@ -95,6 +98,12 @@ struct SharedGroupOptions {
     /// A prerequisite is compiling with REALM_METRICS=ON.
     bool enable_metrics;
 
+    /// If set, the results of queries run in read transactions are shared
+    /// through this cache with all other SharedGroup objects that use the same
+    /// cache. All of them must access the same Realm file. See
+    /// QueryResultCache.
+    std::shared_ptr<QueryResultCache> query_cache;
+
     /// sys_tmp_dir will be used if the temp_dir is empty when creating SharedGroupOptions.
     /// It must be writable and allowed to create pipe/fifo file on it.
     /// set_sys_tmp_dir is not a thread-safe call and it is only supposed to be called once
@@ -0,0 +1,632 @@
+/*************************************************************************
+ *
+ * Copyright 2016 Realm Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ **************************************************************************/
+
+#ifndef REALM_IMPL_COLUMN_READER_HPP
+#define REALM_IMPL_COLUMN_READER_HPP
+
+#include <cstddef>
+#include <iterator>
+
+#include <realm/array_binary.hpp>
+#include <realm/array_blobs_big.hpp>
+#include <realm/array_string.hpp>
+#include <realm/array_string_long.hpp>
+#include <realm/column.hpp>
+#include <realm/column_binary.hpp>
+#include <realm/column_linklist.hpp>
+#include <realm/column_string.hpp>
+#include <realm/column_string_enum.hpp>
+#include <realm/column_timestamp.hpp>
+
+namespace realm {
+
+template <class ColType>
+class ColumnReaderIterator;
+
+
+/// Reads the values of a column while caching the B+-tree leaf that holds the
+/// most recently read row, along with the range of rows in that leaf. Reading
+/// another row of the same leaf is then an array lookup, and the tree is only
+/// descended again when a row of another leaf is read. A pass over all the
+/// rows of a column, or over rows that are mostly in ascending order, costs
+/// O(n) instead of O(n log n).
+///
+/// The reader is specialized for every kind of column:
+///
+///     ColType            value_type
+///     ----------------------------------------------
+///     IntegerColumn      int64_t
+///     IntNullColumn      util::Optional<int64_t>
+///     FloatColumn        float
+///     DoubleColumn       double
+///     StringColumn       StringData
+///     StringEnumColumn   StringData
+///     BinaryColumn       BinaryData
+///     TimestampColumn    Timestamp
+///     LinkListColumn     size_t (the number of links)
+///
+/// get() returns what the getter of the column would return for the same row,
+/// and is_null() what ColumnBase::is_null() would return.
+///
+/// The cached leaf accessor refers to the memory of the leaf, so a reader must
+/// not be used after the column has been modified. Readers are meant to be
+/// local to a single pass over a column.
+///
+/// begin() and end() give random access iterators over all the rows of the
+/// column.
+template <class ColType>
+class ColumnReader {
+public:
+    using value_type = typename ColType::value_type;
+    using iterator = ColumnReaderIterator<ColType>;
+
+    explicit ColumnReader(const ColType& column) noexcept
+        : m_column(column)
+        , m_fallback(column.get_alloc())
+        , m_nullable(column.is_nullable())
+    {
+    }
+
+    value_type get(size_t row_ndx) noexcept
+    {
+        cache_leaf(row_ndx);
+        return m_leaf->get(row_ndx - m_leaf_begin);
+    }
+
+    bool is_null(size_t row_ndx) noexcept
+    {
+        cache_leaf(row_ndx);
+        return m_nullable && _impl::NullableOrNothing<LeafType>::is_null(*m_leaf, row_ndx - m_leaf_begin);
+    }
+
+    size_t size() const noexcept
+    {
+        return m_column.size();
+    }
+
+    iterator begin() noexcept;
+    iterator end() noexcept;
+
+private:
+    using LeafType = typename ColType::LeafType;
+
+    const ColType& m_column;
+    LeafType m_fallback;
+    const LeafType* m_leaf = nullptr;
+    size_t m_leaf_begin = 0;
+    size_t m_leaf_end = 0;
+    const bool m_nullable;
+
+    void cache_leaf(size_t row_ndx) noexcept
+    {
+        if (REALM_LIKELY(row_ndx >= m_leaf_begin && row_ndx < m_leaf_end))
+            return;
+        typename ColType::LeafInfo leaf{&m_leaf, &m_fallback};
+        size_t ndx_in_leaf;
+        m_column.get_leaf(row_ndx, ndx_in_leaf, leaf);
+        m_leaf_begin = row_ndx - ndx_in_leaf;
+        m_leaf_end = m_leaf_begin + m_leaf->size();
+    }
+};
+
+
+namespace _impl {
+
+// Finds the leaf of a column whose leaves are not all of the same type (see
+// ColumnBaseSimple), and the index of the row within it.
+inline MemRef get_column_leaf(const Array& root, size_t row_ndx, size_t& ndx_in_leaf) noexcept
+{
+    if (!root.is_inner_bptree_node()) {
+        ndx_in_leaf = row_ndx;
+        return root.get_mem();
+    }
+    std::pair<MemRef, size_t> p = static_cast<const BpTreeNode&>(root).get_bptree_leaf(row_ndx);
+    ndx_in_leaf = p.second;
+    return p.first;
+}
+
+} // namespace _impl
+
+
+template <>
+class ColumnReader<StringColumn> {
+public:
+    using value_type = StringData;
+    using iterator = ColumnReaderIterator<StringColumn>;
+
+    explicit ColumnReader(const StringColumn& column) noexcept
+        : m_column(column)
+        , m_small(column.get_alloc(), column.is_nullable())
+        , m_medium(column.get_alloc(), column.is_nullable())
+        , m_big(column.get_alloc(), column.is_nullable())
+    {
+    }
+
+    StringData get(size_t row_ndx) noexcept
+    {
+        cache_leaf(row_ndx);
+        size_t ndx_in_leaf = row_ndx - m_leaf_begin;
+        switch (m_leaf_type) {
+            case StringColumn::leaf_type_Small:
+                return m_small.get(ndx_in_leaf);
+            case StringColumn::leaf_type_Medium:
+                return m_medium.get(ndx_in_leaf);
+            case StringColumn::leaf_type_Big:
+                return m_big.get_string(ndx_in_leaf);
+        }
+        REALM_UNREACHABLE();
+    }
+
+    bool is_null(size_t row_ndx) noexcept
+    {
+        return get(row_ndx).is_null();
+    }
+
+    size_t size() const noexcept
+    {
+        return m_column.size();
+    }
+
+    iterator begin() noexcept;
+    iterator end() noexcept;
+
+private:
+    const StringColumn& m_column;
+    ArrayString m_small;
+    ArrayStringLong m_medium;
+    ArrayBigBlobs m_big;
+    StringColumn::LeafType m_leaf_type = StringColumn::leaf_type_Small;
+    size_t m_leaf_begin = 0;
+    size_t m_leaf_end = 0;
+
+    void cache_leaf(size_t row_ndx) noexcept
+    {
+        if (REALM_LIKELY(row_ndx >= m_leaf_begin && row_ndx < m_leaf_end))
+            return;
+        size_t ndx_in_leaf;
+        MemRef mem = _impl::get_column_leaf(*m_column.get_root_array(), row_ndx, ndx_in_leaf);
+        size_t leaf_size;
+        if (!Array::get_hasrefs_from_header(mem.get_addr())) {
+            m_leaf_type = StringColumn::leaf_type_Small;
+            m_small.init_from_mem(mem);
+            leaf_size = m_small.size();
+        }
+        else if (!Array::get_context_flag_from_header(mem.get_addr())) {
+            m_leaf_type = StringColumn::leaf_type_Medium;
+            m_medium.init_from_mem(mem);
+            leaf_size = m_medium.size();
+        }
+        else {
+            m_leaf_type = StringColumn::leaf_type_Big;
+            m_big.init_from_mem(mem);
+            leaf_size = m_big.size();
+        }
+        m_leaf_begin = row_ndx - ndx_in_leaf;
+        m_leaf_end = m_leaf_begin + leaf_size;
+    }
+};
+
+
+template <>
+class ColumnReader<StringEnumColumn> {
+public:
+    using value_type = StringData;
+    using iterator = ColumnReaderIterator<StringEnumColumn>;
+
+    explicit ColumnReader(const StringEnumColumn& column) noexcept
+        : m_keys(column)
+        , m_values(column.get_keys())
+    {
+    }
+
+    StringData get(size_t row_ndx) noexcept
+    {
+        return m_values.get(get_key(row_ndx));
+    }
+
+    bool is_null(size_t row_ndx) noexcept
+    {
+        return get(row_ndx).is_null();
+    }
+
+    /// The index of the string of the row among the distinct strings of the
+    /// column, which is the same for equal strings.
+    size_t get_key(size_t row_ndx) noexcept
+    {
+        return size_t(m_keys.get(row_ndx));
+    }
+
+    size_t size() const noexcept
+    {
+        return m_keys.size();
+    }
+
+    iterator begin() noexcept;
+    iterator end() noexcept;
+
+private:
+    ColumnReader<IntegerColumn> m_keys;
+    ColumnReader<StringColumn> m_values;
+};
+
+
+template <>
+class ColumnReader<BinaryColumn> {
+public:
+    using value_type = BinaryData;
+    using iterator = ColumnReaderIterator<BinaryColumn>;
+
+    explicit ColumnReader(const BinaryColumn& column) noexcept
+        : m_column(column)
+        , m_small(column.get_alloc())
+        , m_big(column.get_alloc(), column.is_nullable())
+        , m_nullable(column.is_nullable())
+    {
+    }
+
+    BinaryData get(size_t row_ndx) noexcept
+    {
+        cache_leaf(row_ndx);
+        size_t ndx_in_leaf = row_ndx - m_leaf_begin;
+        BinaryData value = m_is_big ? m_big.get(ndx_in_leaf) : m_small.get(ndx_in_leaf);
+        if (!m_nullable && value.is_null())
+            return BinaryData("", 0); // Empty (non-null), see BinaryColumn::get()
+        return value;
+    }
+
+    bool is_null(size_t row_ndx) noexcept
+    {
+        return m_nullable && get(row_ndx).is_null();
+    }
+
+    size_t size() const noexcept
+    {
+        return m_column.size();
+    }
+
+    iterator begin() noexcept;
+    iterator end() noexcept;
+
+private:
+    const BinaryColumn& m_column;
+    ArrayBinary m_small;
+    ArrayBigBlobs m_big;
+    const bool m_nullable;
+    bool m_is_big = false;
+    size_t m_leaf_begin = 0;
+    size_t m_leaf_end = 0;
+
+    void cache_leaf(size_t row_ndx) noexcept
+    {
+        if (REALM_LIKELY(row_ndx >= m_leaf_begin && row_ndx < m_leaf_end))
+            return;
+        size_t ndx_in_leaf;
+        MemRef mem = _impl::get_column_leaf(*m_column.get_root_array(), row_ndx, ndx_in_leaf);
+        size_t leaf_size;
+        m_is_big = Array::get_context_flag_from_header(mem.get_addr());
+        if (m_is_big) {
+            m_big.init_from_mem(mem);
+            leaf_size = m_big.size();
+        }
+        else {
+            m_small.init_from_mem(mem);
+            leaf_size = m_small.size();
+        }
+        m_leaf_begin = row_ndx - ndx_in_leaf;
+        m_leaf_end = m_leaf_begin + leaf_size;
+    }
+};
+
+
+template <>
+class ColumnReader<TimestampColumn> {
+public:
+    using value_type = Timestamp;
+    using iterator = ColumnReaderIterator<TimestampColumn>;
+
+    explicit ColumnReader(const TimestampColumn& column) noexcept
+        : m_column(column)
+        , m_seconds_fallback(column.get_alloc())
+        , m_nanoseconds_fallback(column.get_alloc())
+    {
+    }
+
+    Timestamp get(size_t row_ndx) noexcept
+    {
+        cache_leaf(row_ndx);
+        size_t ndx_in_leaf = row_ndx - m_leaf_begin;
+        util::Optional<int64_t> seconds = m_seconds_leaf->get(ndx_in_leaf);
+        if (!seconds)
+            return Timestamp{};
+        return Timestamp(*seconds, int32_t(m_nanoseconds_leaf->get(ndx_in_leaf)));
+    }
+
+    bool is_null(size_t row_ndx) noexcept
+    {
+        cache_leaf(row_ndx);
+        return m_seconds_leaf->is_null(row_ndx - m_leaf_begin);
+    }
+
+    size_t size() const noexcept
+    {
+        return m_column.size();
+    }
+
+    iterator begin() noexcept;
+    iterator end() noexcept;
+
+private:
+    using SecondsTree = BpTree<util::Optional<int64_t>>;
+    using NanosecondsTree = BpTree<int64_t>;
+
+    const TimestampColumn& m_column;
+    SecondsTree::LeafType m_seconds_fallback;
+    NanosecondsTree::LeafType m_nanoseconds_fallback;
+    const SecondsTree::LeafType* m_seconds_leaf = nullptr;
+    const NanosecondsTree::LeafType* m_nanoseconds_leaf = nullptr;
+    size_t m_leaf_begin = 0;
+    size_t m_leaf_end = 0;
+
+    void cache_leaf(size_t row_ndx) noexcept
+    {
+        if (REALM_LIKELY(row_ndx >= m_leaf_begin && row_ndx < m_leaf_end))
+            return;
+        // Both trees have the same shape, as they are always modified together
+        size_t ndx_in_leaf;
+        SecondsTree::LeafInfo seconds{&m_seconds_leaf, &m_seconds_fallback};
+        m_column.m_seconds->get_leaf(row_ndx, ndx_in_leaf, seconds);
+        NanosecondsTree::LeafInfo nanoseconds{&m_nanoseconds_leaf, &m_nanoseconds_fallback};
+        m_column.m_nanoseconds->get_leaf(row_ndx, ndx_in_leaf, nanoseconds);
+        m_leaf_begin = row_ndx - ndx_in_leaf;
+        m_leaf_end = m_leaf_begin + m_seconds_leaf->size();
+    }
+};
+
+
+template <>
+class ColumnReader<LinkListColumn> {
+public:
+    using value_type = size_t;
+    using iterator = ColumnReaderIterator<LinkListColumn>;
+
+    explicit ColumnReader(const LinkListColumn& column) noexcept
+        : m_refs(column)
+        , m_alloc(column.get_alloc())
+    {
+    }
+
+    /// The number of links of the row, as LinkListColumn::get_link_count().
+    size_t get(size_t row_ndx) noexcept
+    {
+        ref_type ref = get_ref(row_ndx);
+        return ref == 0 ? 0 : ColumnBase::get_size_from_ref(ref, m_alloc);
+    }
+
+    bool is_null(size_t) noexcept
+    {
+        return false;
+    }
+
+    /// The ref of the list of links of the row, or zero if it has no links.
+    ref_type get_ref(size_t row_ndx) noexcept
+    {
+        return to_ref(m_refs.get(row_ndx));
+    }
+
+    size_t size() const noexcept
+    {
+        return m_refs.size();
+    }
+
+    iterator begin() noexcept;
+    iterator end() noexcept;
+
+private:
+    ColumnReader<IntegerColumn> m_refs;
+    Allocator& m_alloc;
+};
+
+
+/// Random access iterator over the rows of a column, reading the values
+/// through a ColumnReader. Dereferencing gives the value by value.
+template <class ColType>
+class ColumnReaderIterator {
+public:
+    using iterator_category = std::random_access_iterator_tag;
+    using value_type = typename ColumnReader<ColType>::value_type;
+    using difference_type = std::ptrdiff_t;
+    using pointer = void;
+    using reference = value_type;
+
+    ColumnReaderIterator(ColumnReader<ColType>& reader, size_t row_ndx) noexcept
+        : m_reader(&reader)
+        , m_row_ndx(row_ndx)
+    {
+    }
+
+    value_type operator*() const noexcept
+    {
+        return m_reader->get(m_row_ndx);
+    }
+
+    value_type operator[](difference_type offset) const noexcept
+    {
+        return m_reader->get(m_row_ndx + offset);
+    }
+
+    size_t get_row_ndx() const noexcept
+    {
+        return m_row_ndx;
+    }
+
+    ColumnReaderIterator& operator++() noexcept
+    {
+        ++m_row_ndx;
+        return *this;
+    }
+
+    ColumnReaderIterator& operator--() noexcept
+    {
+        --m_row_ndx;
+        return *this;
+    }
+
+    ColumnReaderIterator operator++(int) noexcept
+    {
+        ColumnReaderIterator i = *this;
+        ++m_row_ndx;
+        return i;
+    }
+
+    ColumnReaderIterator operator--(int) noexcept
+    {
+        ColumnReaderIterator i = *this;
+        --m_row_ndx;
+        return i;
+    }
+
+    ColumnReaderIterator& operator+=(difference_type offset) noexcept
+    {
+        m_row_ndx += offset;
+        return *this;
+    }
+
+    ColumnReaderIterator& operator-=(difference_type offset) noexcept
+    {
+        m_row_ndx -= offset;
+        return *this;
+    }
+
+    ColumnReaderIterator operator+(difference_type offset) const noexcept
+    {
+        return ColumnReaderIterator(*m_reader, m_row_ndx + offset);
+    }
+
+    ColumnReaderIterator operator-(difference_type offset) const noexcept
+    {
+        return ColumnReaderIterator(*m_reader, m_row_ndx - offset);
+    }
+
+    difference_type operator-(const ColumnReaderIterator& other) const noexcept
+    {
+        return difference_type(m_row_ndx) - difference_type(other.m_row_ndx);
+    }
+
+    bool operator==(const ColumnReaderIterator& other) const noexcept
+    {
+        return m_row_ndx == other.m_row_ndx;
+    }
+
+    bool operator!=(const ColumnReaderIterator& other) const noexcept
+    {
+        return m_row_ndx != other.m_row_ndx;
+    }
+
+    bool operator<(const ColumnReaderIterator& other) const noexcept
+    {
+        return m_row_ndx < other.m_row_ndx;
+    }
+
+    bool operator>(const ColumnReaderIterator& other) const noexcept
+    {
+        return m_row_ndx > other.m_row_ndx;
+    }
+
+    bool operator<=(const ColumnReaderIterator& other) const noexcept
+    {
+        return m_row_ndx <= other.m_row_ndx;
+    }
+
+    bool operator>=(const ColumnReaderIterator& other) const noexcept
+    {
+        return m_row_ndx >= other.m_row_ndx;
+    }
+
+private:
+    ColumnReader<ColType>* m_reader;
+    size_t m_row_ndx;
+};
+
+
+// Implementation
+
+template <class ColType>
+inline ColumnReaderIterator<ColType> ColumnReader<ColType>::begin() noexcept
+{
+    return iterator(*this, 0);
+}
+
+template <class ColType>
+inline ColumnReaderIterator<ColType> ColumnReader<ColType>::end() noexcept
+{
+    return iterator(*this, size());
+}
+
+inline ColumnReaderIterator<StringColumn> ColumnReader<StringColumn>::begin() noexcept
+{
+    return iterator(*this, 0);
+}
+
+inline ColumnReaderIterator<StringColumn> ColumnReader<StringColumn>::end() noexcept
+{
+    return iterator(*this, size());
+}
+
+inline ColumnReaderIterator<StringEnumColumn> ColumnReader<StringEnumColumn>::begin() noexcept
+{
+    return iterator(*this, 0);
+}
+
+inline ColumnReaderIterator<StringEnumColumn> ColumnReader<StringEnumColumn>::end() noexcept
+{
+    return iterator(*this, size());
+}
+
+inline ColumnReaderIterator<BinaryColumn> ColumnReader<BinaryColumn>::begin() noexcept
+{
+    return iterator(*this, 0);
+}
+
+inline ColumnReaderIterator<BinaryColumn> ColumnReader<BinaryColumn>::end() noexcept
+{
+    return iterator(*this, size());
+}
+
+inline ColumnReaderIterator<TimestampColumn> ColumnReader<TimestampColumn>::begin() noexcept
+{
+    return iterator(*this, 0);
+}
+
+inline ColumnReaderIterator<TimestampColumn> ColumnReader<TimestampColumn>::end() noexcept
+{
+    return iterator(*this, size());
+}
+
+inline ColumnReaderIterator<LinkListColumn> ColumnReader<LinkListColumn>::begin() noexcept
+{
+    return iterator(*this, 0);
+}
+
+inline ColumnReaderIterator<LinkListColumn> ColumnReader<LinkListColumn>::end() noexcept
+{
+    return iterator(*this, size());
+}
+
+} // namespace realm
+
+#endif // REALM_IMPL_COLUMN_READER_HPP
@@ -56,6 +56,26 @@ void Metrics::add_transaction(TransactionInfo info)
     m_transaction_info->push_back(info);
 }
 
+void Metrics::add_query_cache_hit() noexcept
+{
+    ++m_query_cache_hits;
+}
+
+void Metrics::add_query_cache_miss() noexcept
+{
+    ++m_query_cache_misses;
+}
+
+size_t Metrics::num_query_cache_hits() const noexcept
+{
+    return m_query_cache_hits;
+}
+
+size_t Metrics::num_query_cache_misses() const noexcept
+{
+    return m_query_cache_misses;
+}
+
 void Metrics::start_read_transaction()
 {
     REALM_ASSERT_DEBUG(!m_pending_read);
@@ -19,6 +19,8 @@
 #ifndef REALM_QUERY_INFO_HPP
 #define REALM_QUERY_INFO_HPP
 
+#include <iomanip>
+#include <limits>
 #include <memory>
 #include <string>
 #include <sstream>
@@ -43,6 +45,24 @@ std::string print_value(T value)
     return ss.str();
 }
 
+// Floating point values are printed with enough digits to tell any two of
+// them apart, since query descriptions are also used to identify queries.
+template <>
+inline std::string print_value(float value)
+{
+    std::stringstream ss;
+    ss << std::setprecision(std::numeric_limits<float>::max_digits10) << value;
+    return ss.str();
+}
+
+template <>
+inline std::string print_value(double value)
+{
+    std::stringstream ss;
+    ss << std::setprecision(std::numeric_limits<double>::max_digits10) << value;
+    return ss.str();
+}
+
 const std::string value_separator = ".";
 
 class QueryInfo {
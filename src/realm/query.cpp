@@ -23,6 +23,7 @@
 #include <realm/descriptor.hpp>
 #include <realm/group_shared.hpp>
 #include <realm/link_view.hpp>
+#include <realm/query_cache.hpp>
 #include <realm/query_engine.hpp>
 #include <realm/query_expression.hpp>
 #include <realm/table_view.hpp>
@@ -908,7 +909,7 @@ R Query::aggregate(R (ColType::*aggregateMethod)(size_t start, size_t end, size_
         }
         else {
             for (size_t t = 0; t < m_view->size(); t++) {
-                size_t tablerow = static_cast<size_t>(m_view->m_row_indexes.get(t));
+                size_t tablerow = static_cast<size_t>(m_view->get_row_index(t));
                 if (tablerow >= start && tablerow < end && peek_tablerow(tablerow) != not_found) {
                     st.template match<action, false>(tablerow, 0, source_column.get_next(tablerow));
                     if (st.m_match_count >= limit) {
@@ -1297,7 +1298,7 @@ size_t Query::find(size_t begin)
     if (!has_conditions()) {
         if (m_view) {
             for (size_t t = 0; t < m_view->size(); t++) {
-                size_t tablerow = static_cast<size_t>(m_view->m_row_indexes.get(t));
+                size_t tablerow = static_cast<size_t>(m_view->get_row_index(t));
                 if (tablerow >= begin)
                     return tablerow;
             }
@@ -1309,7 +1310,7 @@ size_t Query::find(size_t begin)
 
     if (m_view) {
         for (size_t t = 0; t < m_view->size(); t++) {
-            size_t tablerow = static_cast<size_t>(m_view->m_row_indexes.get(t));
+            size_t tablerow = static_cast<size_t>(m_view->get_row_index(t));
             if (tablerow >= begin && peek_tablerow(tablerow) != not_found)
                 return tablerow;
         }
@@ -1327,6 +1328,64 @@ void Query::find_all(TableViewBase& ret, size_t begin, size_t end, size_t limit)
     if (limit == 0 || m_table->is_degenerate())
         return;
 
+    uint_fast64_t version = 0;
+    QueryResultCache* cache = nullptr;
+    if (begin == 0 && end == size_t(-1) && limit == size_t(-1))
+        cache = get_result_cache(version);
+    if (!cache) {
+        do_find_all(ret, begin, end, limit); // Throws
+        return;
+    }
+
+    // Share the result with other threads that run the same query on the same
+    // snapshot
+    size_t table_ndx = m_table->get_index_in_group();
+    std::string description = get_description(); // Throws
+#if REALM_METRICS
+    std::shared_ptr<metrics::Metrics> metrics = _impl::GroupFriend::get_metrics(*m_table->get_parent_group());
+#endif
+    if (QueryResultCache::Result result = cache->lookup(version, table_ndx, description)) { // Throws
+#if REALM_METRICS
+        if (metrics)
+            metrics->add_query_cache_hit();
+#endif
+        ret.assign_row_bitmap(*result); // Throws
+        return;
+    }
+#if REALM_METRICS
+    if (metrics)
+        metrics->add_query_cache_miss();
+#endif
+
+    do_find_all(ret, begin, end, limit); // Throws
+    std::shared_ptr<RowBitmap> rows = std::make_shared<RowBitmap>(); // Throws
+    if (ret.m_row_bitmap) {
+        *rows = *ret.m_row_bitmap; // Throws
+    }
+    else {
+        for (size_t i = 0, n = ret.m_row_indexes.size(); i < n; ++i)
+            rows->add(to_size_t(ret.m_row_indexes.get(i))); // Throws
+    }
+    cache->insert(version, table_ndx, description, std::move(rows)); // Throws
+}
+
+// Only results over a whole group-level table, computed within a read
+// transaction, can be shared through the cache. They are identified by the
+// query description, which is only available when metrics are enabled.
+QueryResultCache* Query::get_result_cache(uint_fast64_t& version) const noexcept
+{
+#if REALM_METRICS
+    if (m_view || !m_subtable_path.empty() || !m_table->is_group_level())
+        return nullptr;
+    return _impl::GroupFriend::get_query_cache(*m_table->get_parent_group(), version);
+#else
+    static_cast<void>(version);
+    return nullptr;
+#endif
+}
+
+void Query::do_find_all(TableViewBase& ret, size_t begin, size_t end, size_t limit) const
+{
     REALM_ASSERT_3(begin, <=, m_table->size());
 
     init();
@@ -1336,25 +1395,45 @@ void Query::find_all(TableViewBase& ret, size_t begin, size_t end, size_t limit)
 
     if (m_view) {
         for (size_t t = 0; t < m_view->size() && ret.size() < limit; t++) {
-            size_t tablerow = static_cast<size_t>(m_view->m_row_indexes.get(t));
+            size_t tablerow = static_cast<size_t>(m_view->get_row_index(t));
             if (tablerow >= begin && tablerow < end && peek_tablerow(tablerow) != not_found) {
                 ret.m_row_indexes.add(tablerow);
             }
         }
+        return;
     }
-    else {
-        if (!has_conditions()) {
-            IntegerColumn& refs = ret.m_row_indexes;
-            for (size_t i = begin; i < end && refs.size() < limit; ++i) {
-                refs.add(i);
-            }
-        }
-        else {
-            QueryState<int64_t> st;
-            st.init(act_FindAll, &ret.m_row_indexes, limit);
-            aggregate_internal(act_FindAll, ColumnTypeTraits<int64_t>::id, false, root_node(), &st, begin, end,
-                               nullptr);
+
+    // Matches are produced in table order, so unless the view is going to be
+    // sorted, they are gathered one bitmap chunk of rows at a time, and moved
+    // into the compact representation of the view as soon as they turn out to
+    // be dense enough. The plain representation then never holds more than
+    // the matches of a single chunk.
+    bool compact = ret.m_descriptor_ordering.is_empty();
+    size_t block_size = compact ? RowBitmap::chunk_size : end - begin;
+    IntegerColumn& refs = ret.m_row_indexes;
+
+    if (!has_conditions()) {
+        size_t count = 0;
+        for (size_t block_begin = begin; block_begin < end && count < limit;) {
+            size_t block_end = std::min(end, block_begin + block_size);
+            for (size_t i = block_begin; i < block_end && count < limit; ++i, ++count)
+                refs.add(i); // Throws
+            if (compact)
+                ret.compact_row_indexes(); // Throws
+            block_begin = block_end;
         }
+        return;
+    }
+
+    QueryState<int64_t> st;
+    st.init(act_FindAll, &refs, limit);
+    for (size_t block_begin = begin; block_begin < end && st.m_match_count < limit;) {
+        size_t block_end = std::min(end, block_begin + block_size);
+        aggregate_internal(act_FindAll, ColumnTypeTraits<int64_t>::id, false, root_node(), &st, block_begin,
+                           block_end, nullptr); // Throws
+        if (compact)
+            ret.compact_row_indexes(); // Throws
+        block_begin = block_end;
     }
 }
 
@@ -1366,6 +1445,7 @@ TableView Query::find_all(size_t start, size_t end, size_t limit)
 
     TableView ret(*m_table, *this, start, end, limit);
     find_all(ret, start, end, limit);
+    ret.reset_row_changes();
     return ret;
 }
 
@@ -1397,7 +1477,7 @@ size_t Query::count(size_t start, size_t end, size_t limit) const
 
     if (m_view) {
         for (size_t t = 0; t < m_view->size() && cnt < limit; t++) {
-            size_t tablerow = static_cast<size_t>(m_view->m_row_indexes.get(t));
+            size_t tablerow = static_cast<size_t>(m_view->get_row_index(t));
             if (tablerow >= start && tablerow < end && peek_tablerow(tablerow) != not_found) {
                 cnt++;
             }
@@ -56,6 +56,7 @@ class Array;
 class Expression;
 class SequentialGetterBase;
 class Group;
+class QueryResultCache;
 
 namespace metrics {
 class QueryInfo;
@@ -419,6 +420,8 @@ private:
                             size_t start, size_t end, SequentialGetterBase* source_column) const;
 
     void find_all(TableViewBase& tv, size_t start = 0, size_t end = size_t(-1), size_t limit = size_t(-1)) const;
+    void do_find_all(TableViewBase& tv, size_t start, size_t end, size_t limit) const;
+    QueryResultCache* get_result_cache(uint_fast64_t& version) const noexcept;
     void delete_nodes() noexcept;
 
     bool has_conditions() const
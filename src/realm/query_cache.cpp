@@ -0,0 +1,167 @@
+/*************************************************************************
+ *
+ * Copyright 2016 Realm Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ **************************************************************************/
+
+#include <realm/query_cache.hpp>
+
+#include <tuple>
+
+#include <realm/util/assert.hpp>
+
+using namespace realm;
+
+
+bool QueryResultCache::Key::operator<(const Key& other) const noexcept
+{
+    return std::tie(version, table_ndx, description) < std::tie(other.version, other.table_ndx, other.description);
+}
+
+
+QueryResultCache::QueryResultCache(size_t max_memory)
+    : m_max_memory(max_memory)
+{
+}
+
+
+QueryResultCache::~QueryResultCache() noexcept
+{
+}
+
+
+QueryResultCache::Result QueryResultCache::lookup(uint_fast64_t version, size_t table_ndx,
+                                                  const std::string& description)
+{
+    Key key{version, table_ndx, description}; // Throws
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto i = m_entries.find(key);
+    if (i == m_entries.end())
+        return nullptr;
+    m_lru.splice(m_lru.begin(), m_lru, i->second.lru);
+    return i->second.result;
+}
+
+
+void QueryResultCache::insert(uint_fast64_t version, size_t table_ndx, const std::string& description,
+                              Result result)
+{
+    REALM_ASSERT(result);
+    size_t memory = sizeof(Key) + sizeof(Entry) + description.size() + result->memory_usage();
+    Key key{version, table_ndx, description}; // Throws
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_versions.count(version) == 0 || memory > m_max_memory)
+        return;
+    if (m_entries.count(key) != 0)
+        return; // Another thread got there first
+
+    evict_until(m_max_memory - memory);
+    m_lru.push_front(nullptr); // Throws
+    try {
+        auto i = m_entries.emplace(std::move(key), Entry{std::move(result), memory, m_lru.begin()}).first; // Throws
+        m_lru.front() = &i->first;
+    }
+    catch (...) {
+        m_lru.pop_front();
+        throw;
+    }
+    m_memory_usage += memory;
+}
+
+
+void QueryResultCache::retain_version(uint_fast64_t version) noexcept
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    try {
+        ++m_versions[version]; // Throws
+    }
+    catch (...) {
+        // The version is then treated as not bound, which only means that no
+        // results are cached for it
+    }
+}
+
+
+void QueryResultCache::release_version(uint_fast64_t version) noexcept
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto i = m_versions.find(version);
+    if (i == m_versions.end())
+        return;
+    if (--i->second != 0)
+        return;
+    m_versions.erase(i);
+
+    // Nobody can ask for the results of this snapshot anymore
+    auto begin = m_entries.lower_bound(Key{version, 0, std::string()});
+    while (begin != m_entries.end() && begin->first.version == version)
+        evict(begin++);
+}
+
+
+size_t QueryResultCache::size() const noexcept
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_entries.size();
+}
+
+
+size_t QueryResultCache::get_memory_usage() const noexcept
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_memory_usage;
+}
+
+
+size_t QueryResultCache::get_max_memory() const noexcept
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_max_memory;
+}
+
+
+void QueryResultCache::set_max_memory(size_t max_memory) noexcept
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_max_memory = max_memory;
+    evict_until(max_memory);
+}
+
+
+void QueryResultCache::clear() noexcept
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_entries.clear();
+    m_lru.clear();
+    m_memory_usage = 0;
+}
+
+
+void QueryResultCache::evict(std::map<Key, Entry>::iterator i) noexcept
+{
+    m_memory_usage -= i->second.memory;
+    m_lru.erase(i->second.lru);
+    m_entries.erase(i);
+}
+
+
+void QueryResultCache::evict_until(size_t max_memory) noexcept
+{
+    while (m_memory_usage > max_memory) {
+        REALM_ASSERT_DEBUG(!m_lru.empty());
+        evict(m_entries.find(*m_lru.back()));
+    }
+}
@@ -0,0 +1,111 @@
+/*************************************************************************
+ *
+ * Copyright 2016 Realm Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ **************************************************************************/
+
+#ifndef REALM_QUERY_CACHE_HPP
+#define REALM_QUERY_CACHE_HPP
+
+#include <cstdint>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include <realm/row_bitmap.hpp>
+
+namespace realm {
+
+/// A cache of query results, which lets threads that run the same query on
+/// the same snapshot share a single evaluation of it. A cache is enabled by
+/// passing it to all the SharedGroup objects that are to share results (see
+/// SharedGroupOptions::query_cache). They must all access the same Realm file.
+///
+/// Only results of Query::find_all() over a whole group-level table are
+/// cached, and only while in a read transaction. A result is keyed by the
+/// version of the snapshot, the index of the table in the group, and the
+/// description of the query (Query::get_description()). The results for a
+/// snapshot are evicted when the last SharedGroup that uses the cache
+/// releases the snapshot, and the least recently used results are evicted
+/// when the memory limit would otherwise be exceeded.
+///
+/// Query descriptions are only available when the library is built with
+/// REALM_METRICS enabled. Without it, nothing is cached.
+///
+/// All member functions are thread-safe.
+class QueryResultCache {
+public:
+    using Result = std::shared_ptr<const RowBitmap>;
+
+    static const size_t default_max_memory = size_t(64) << 20;
+
+    explicit QueryResultCache(size_t max_memory = default_max_memory);
+    ~QueryResultCache() noexcept;
+
+    /// Returns null if no result is cached for the specified query.
+    Result lookup(uint_fast64_t version, size_t table_ndx, const std::string& description);
+
+    /// Add a result to the cache. This is ignored if no SharedGroup that uses
+    /// the cache has the specified version bound, or if the result alone
+    /// exceeds the memory limit.
+    void insert(uint_fast64_t version, size_t table_ndx, const std::string& description, Result);
+
+    /// Called by SharedGroup whenever it binds or releases a snapshot.
+    void retain_version(uint_fast64_t version) noexcept;
+    void release_version(uint_fast64_t version) noexcept;
+
+    /// The number of cached results.
+    size_t size() const noexcept;
+
+    /// An estimate of the number of bytes of memory used by the cached results.
+    size_t get_memory_usage() const noexcept;
+
+    size_t get_max_memory() const noexcept;
+    void set_max_memory(size_t max_memory) noexcept;
+
+    void clear() noexcept;
+
+private:
+    struct Key {
+        uint_fast64_t version;
+        size_t table_ndx;
+        std::string description;
+        bool operator<(const Key&) const noexcept;
+    };
+    struct Entry {
+        Result result;
+        size_t memory;
+        // Position in m_lru
+        std::list<const Key*>::iterator lru;
+    };
+
+    mutable std::mutex m_mutex;
+    std::map<Key, Entry> m_entries;
+    // Keys of m_entries, most recently used first
+    std::list<const Key*> m_lru;
+    // Number of bound snapshots of each version
+    std::map<uint_fast64_t, size_t> m_versions;
+    size_t m_memory_usage = 0;
+    size_t m_max_memory;
+
+    void evict(std::map<Key, Entry>::iterator) noexcept;
+    void evict_until(size_t max_memory) noexcept;
+};
+
+} // namespace realm
+
+#endif // REALM_QUERY_CACHE_HPP
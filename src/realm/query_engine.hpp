@@ -1008,6 +1008,12 @@ public:
         return not_found;
     }
 
+    virtual std::string describe() const override
+    {
+        return this->describe_column() + ".size() " + TConditionFunction::description() + " " +
+               metrics::print_value(m_value);
+    }
+
     std::unique_ptr<ParentNode> clone(QueryNodeHandoverPatches* patches) const override
     {
         return std::unique_ptr<ParentNode>(new SizeNode(*this, patches));
@@ -1080,7 +1086,7 @@ public:
     virtual std::string describe() const override
     {
         return this->describe_column() + " " + TConditionFunction::description() + " \""
-            + metrics::print_value(BinaryNode::m_value.data()) + "\"";
+            + metrics::print_value(std::string(BinaryNode::m_value.data(), BinaryNode::m_value.size())) + "\"";
     }
 
     std::unique_ptr<ParentNode> clone(QueryNodeHandoverPatches* patches) const override
@@ -1949,6 +1955,12 @@ public:
         return not_found;
     }
 
+    virtual std::string describe() const override
+    {
+        return this->describe_column(m_condition_column_idx1) + " " + TConditionFunction::description() + " " +
+               this->describe_column(m_condition_column_idx2);
+    }
+
     std::unique_ptr<ParentNode> clone(QueryNodeHandoverPatches* patches) const override
     {
         return std::unique_ptr<ParentNode>(new TwoColumnsNode<ColType, TConditionFunction>(*this, patches));
@@ -1987,6 +1999,7 @@ class ExpressionNode : public ParentNode {
 public:
     ExpressionNode(std::unique_ptr<Expression>);
 
+    void init() override;
     size_t find_first_local(size_t start, size_t end) override;
 
     void table_changed() override;
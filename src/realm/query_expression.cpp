@@ -16,10 +16,93 @@
  *
  **************************************************************************/
 
+#include <algorithm>
+
 #include <realm/query_expression.hpp>
 
 namespace realm {
 
+namespace {
+
+struct FindTargetMatch : public LinkMapFunction {
+    FindTargetMatch(const std::vector<bool>& target_matches)
+        : m_target_matches(target_matches)
+    {
+    }
+
+    bool consume(size_t row_index) override
+    {
+        m_has_link = true;
+        if (m_target_matches[row_index])
+            m_match = true;
+        return !m_match;
+    }
+
+    const std::vector<bool>& m_target_matches;
+    bool m_has_link = false;
+    bool m_match = false;
+};
+
+} // anonymous namespace
+
+LinkSemiJoin::LinkSemiJoin(LinkMap& link_map, std::vector<bool> target_matches, bool empty_matches)
+    : m_link_map(link_map)
+    , m_target_matches(std::move(target_matches))
+    , m_empty_matches(empty_matches)
+{
+    // Backlinks lead only to rows that have links, and are only followed for
+    // a single forward link column
+    if (m_empty_matches || link_map.m_link_columns.size() != 1 || link_map.m_link_types[0] == col_type_BackLink)
+        return;
+
+    // Assuming that the links are evenly distributed over the target rows,
+    // following backlinks is cheaper when less than about one in eight target
+    // rows match
+    size_t num_target_rows = m_target_matches.size();
+    size_t num_matches = size_t(std::count(m_target_matches.begin(), m_target_matches.end(), true));
+    if (num_matches * 8 > num_target_rows)
+        return;
+
+    const LinkColumnBase& links = *static_cast<const LinkColumnBase*>(link_map.m_link_columns[0]);
+    const BacklinkColumn& backlinks = links.get_backlink_column();
+    for (size_t i = 0; i < num_target_rows; ++i) {
+        if (!m_target_matches[i])
+            continue;
+        size_t n = backlinks.get_backlink_count(i);
+        for (size_t j = 0; j < n; ++j)
+            m_base_matches.push_back(backlinks.get_backlink(i, j)); // Throws
+    }
+    // A link list may link to the same row more than once
+    std::sort(m_base_matches.begin(), m_base_matches.end());
+    m_base_matches.erase(std::unique(m_base_matches.begin(), m_base_matches.end()), m_base_matches.end());
+    m_use_backlinks = true;
+}
+
+size_t LinkSemiJoin::find_first(size_t start, size_t end)
+{
+    if (m_use_backlinks) {
+        auto i = std::lower_bound(m_base_matches.begin(), m_base_matches.end(), start);
+        if (i != m_base_matches.end() && *i < end)
+            return *i;
+        return not_found;
+    }
+
+    for (; start < end; ++start) {
+        FindTargetMatch find(m_target_matches);
+        m_link_map.map_links(start, find);
+        if (find.m_has_link ? find.m_match : m_empty_matches)
+            return start;
+    }
+    return not_found;
+}
+
+bool LinkSemiJoin::is_beneficial(const LinkMap& link_map)
+{
+    // The condition is evaluated once for every target row, instead of once
+    // for every base row, and following a link to test a target row is cheap
+    return link_map.target_table()->size() < link_map.base_table()->size();
+}
+
 void Columns<Link>::evaluate(size_t index, ValueBase& destination)
 {
     std::vector<size_t> links = m_link_map.get_links(index);
@@ -397,6 +397,12 @@ public:
     virtual void apply_handover_patch(QueryNodeHandoverPatches&, Group&)
     {
     }
+
+    // Called each time a query that contains the expression is about to be
+    // executed, after set_base_table().
+    virtual void init()
+    {
+    }
 };
 
 template <typename T, typename... Args>
@@ -405,6 +411,8 @@ std::unique_ptr<Expression> make_expression(Args&&... args)
     return std::unique_ptr<Expression>(new T(std::forward<Args>(args)...));
 }
 
+class LinkMap;
+
 class Subexpr {
 public:
     virtual ~Subexpr()
@@ -439,6 +447,22 @@ public:
     }
 
     virtual void evaluate(size_t index, ValueBase& destination) = 0;
+
+    // If the subexpression is the value of a column in a table that is reached
+    // through links, returns the links. Used to evaluate conditions on such
+    // columns as semijoins (see LinkSemiJoin).
+    virtual LinkMap* get_link_map()
+    {
+        return nullptr;
+    }
+
+    // Returns a subexpression that reads the column of a subexpression with a
+    // link map directly from the target table of the links, or null if that is
+    // not supported.
+    virtual std::unique_ptr<Subexpr> clone_for_target_table() const
+    {
+        return nullptr;
+    }
 };
 
 template <typename T, typename... Args>
@@ -1951,6 +1975,39 @@ private:
 
     template <class>
     friend Query compare(const Subexpr2<Link>&, const ConstRow&);
+    friend class LinkSemiJoin;
+};
+
+// Evaluates a condition on a column of a table reached through links as a
+// semijoin. The condition is evaluated once for each row of the target table,
+// and a row of the base table then matches if any of the rows it links to
+// does. This pays off when many rows link to the same target rows, as in
+// `order.customer.country == "DE"`.
+//
+// When few target rows match, the matching base rows are found by following
+// the backlinks of the matching target rows instead of the links of every
+// base row.
+class LinkSemiJoin {
+public:
+    // `target_matches` holds the result of the condition for each row of the
+    // target table, and `empty_matches` the result for a base row whose links
+    // lead to no target row.
+    LinkSemiJoin(LinkMap& link_map, std::vector<bool> target_matches, bool empty_matches);
+
+    size_t find_first(size_t start, size_t end);
+
+    // Returns true if evaluating a condition on the target table of the links
+    // is estimated to be cheaper than evaluating it for every row of the base
+    // table.
+    static bool is_beneficial(const LinkMap& link_map);
+
+private:
+    LinkMap& m_link_map;
+    std::vector<bool> m_target_matches;
+    bool m_empty_matches;
+    bool m_use_backlinks = false;
+    // Sorted indexes of the matching base rows, if m_use_backlinks is true
+    std::vector<size_t> m_base_matches;
 };
 
 template <class T, class S, class I>
@@ -2049,6 +2106,16 @@ public:
         return m_link_map.m_link_columns.size() > 0;
     }
 
+    LinkMap* get_link_map() override
+    {
+        return links_exist() ? &m_link_map : nullptr;
+    }
+
+    std::unique_ptr<Subexpr> clone_for_target_table() const override
+    {
+        return make_subexpr<Columns<T>>(column_ndx(), m_link_map.target_table());
+    }
+
     virtual std::string description() const override
     {
         if (links_exist()) {
@@ -3122,6 +3189,16 @@ public:
         return m_link_map.m_link_columns.size() > 0;
     }
 
+    LinkMap* get_link_map() override
+    {
+        return links_exist() ? &m_link_map : nullptr;
+    }
+
+    std::unique_ptr<Subexpr> clone_for_target_table() const override
+    {
+        return make_subexpr<Columns<T>>(column_ndx(), m_link_map.target_table());
+    }
+
     bool is_nullable() const
     {
         return m_nullable;
@@ -3699,6 +3776,7 @@ public:
     // See comment in base class
     void set_base_table(const Table* table) override
     {
+        m_semi_join.reset();
         m_left->set_base_table(table);
         m_right->set_base_table(table);
     }
@@ -3709,6 +3787,58 @@ public:
         m_right->verify_column();
     }
 
+    // A comparison of a column reached through links with a constant is
+    // evaluated as a semijoin when that is estimated to be cheaper
+    void init() override
+    {
+        m_semi_join.reset();
+
+        bool links_on_left = !m_right->get_base_table();
+        Subexpr& linked = links_on_left ? static_cast<Subexpr&>(*m_left) : static_cast<Subexpr&>(*m_right);
+        Subexpr& constant = links_on_left ? static_cast<Subexpr&>(*m_right) : static_cast<Subexpr&>(*m_left);
+        if (constant.get_base_table())
+            return;
+        LinkMap* link_map = linked.get_link_map();
+        if (!link_map || !LinkSemiJoin::is_beneficial(*link_map))
+            return;
+        std::unique_ptr<Subexpr> target_column = linked.clone_for_target_table(); // Throws
+        if (!target_column)
+            return;
+
+        // Evaluate the condition over the target table
+        const Table* target_table = link_map->target_table();
+        std::unique_ptr<Subexpr> target_constant = constant.clone(); // Throws
+        std::unique_ptr<Compare<TCond, T>> target_compare;
+        if (links_on_left) {
+            target_compare.reset(new Compare<TCond, T>(std::move(target_column), std::move(target_constant)));
+        }
+        else {
+            target_compare.reset(new Compare<TCond, T>(std::move(target_constant), std::move(target_column)));
+        }
+        target_compare->set_base_table(target_table);
+        size_t end = target_table->size();
+        std::vector<bool> target_matches(end); // Throws
+        size_t match = target_compare->find_first(0, end);
+        while (match != not_found) {
+            target_matches[match] = true;
+            match = target_compare->find_first(match + 1, end);
+        }
+
+        // The condition is evaluated differently for rows whose links lead
+        // nowhere, e.g. `link.value == null` matches null links
+        Value<T> no_links = make_value_for_link<T>(link_map->only_unary_links(), 0);
+        Value<T> value;
+        constant.evaluate(0, value);
+        if (links_on_left) {
+            match = Value<T>::template compare<TCond>(&no_links, &value);
+        }
+        else {
+            match = Value<T>::template compare<TCond>(&value, &no_links);
+        }
+
+        m_semi_join.reset(new LinkSemiJoin(*link_map, std::move(target_matches), match != not_found)); // Throws
+    }
+
     // Recursively fetch tables of columns in expression tree. Used when user first builds a stand-alone expression
     // and
     // binds it to a Query at a later time
@@ -3726,6 +3856,9 @@ public:
 
     size_t find_first(size_t start, size_t end) const override
     {
+        if (m_semi_join)
+            return m_semi_join->find_first(start, end);
+
         size_t match;
         Value<T> right;
         Value<T> left;
@@ -3772,6 +3905,7 @@ private:
 
     std::unique_ptr<TLeft> m_left;
     std::unique_ptr<TRight> m_right;
+    std::unique_ptr<LinkSemiJoin> m_semi_join;
 };
 }
 #endif // REALM_QUERY_EXPRESSION_HPP
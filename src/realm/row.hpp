@@ -31,6 +31,8 @@ namespace realm {
 
 template <class>
 class BasicRow;
+template <class>
+class BasicRowHandle;
 
 
 /// This class is a "mixin" and contains the common set of functions for several
@@ -226,6 +228,11 @@ private:
     template <class>
     friend class BasicRow;
 
+    // Make m_table and m_row_ndx accessible from
+    // BasicRowHandle::BasicRowHandle(BasicRowExpr<U>) for any U.
+    template <class>
+    friend class BasicRowHandle;
+
     // Make BasicRowExpr(T*, size_t) accessible from Table.
     friend class Table;
 };
@@ -334,6 +341,11 @@ private:
     template <class>
     friend class BasicRowExpr;
 
+    // Make m_table and m_row_ndx accessible from BasicRowHandle(const
+    // BasicRow<U>&) for any U.
+    template <class>
+    friend class BasicRowHandle;
+
 public:
     std::unique_ptr<BasicRow<T>> clone_for_handover(std::unique_ptr<HandoverPatch>& patch) const
     {
@@ -371,6 +383,71 @@ typedef BasicRow<Table> Row;
 typedef BasicRow<const Table> ConstRow;
 
 
+/// A row accessor that is not registered with its table (an "untracked row
+/// handle").
+///
+/// Like a real row accessor (`BasicRow`), a row handle keeps the parent table
+/// accessor alive, but it is not linked into the table's list of row
+/// accessors. Creating, copying and destroying a handle is therefore cheap,
+/// and live handles add nothing to the cost of inserting, removing or moving
+/// rows.
+///
+/// Instead of being adjusted when rows are inserted before it, removed or
+/// moved, a handle records the table's row index version when it is created,
+/// and is checked against it on every access. As soon as any rows are
+/// inserted other than at the end, removed or moved in the table, or the
+/// table accessor is detached, the handle becomes detached (is_attached()
+/// returns false). Setting values in the table does not affect handles. As
+/// for any detached row accessor, only is_attached(), detach(), get_table(),
+/// get_index() and the destructor may then be called.
+///
+/// Use a real row accessor when the accessor must follow its row across such
+/// changes.
+///
+///     RowHandle row = table[7];
+///     if (row.is_attached())
+///         row.set_int(0, 1);
+///
+/// \sa RowFuncs
+template <class T>
+class BasicRowHandle : public RowFuncs<T, BasicRowHandle<T>> {
+public:
+    BasicRowHandle() noexcept = default;
+
+    template <class U>
+    BasicRowHandle(BasicRowExpr<U>) noexcept;
+
+    template <class U>
+    BasicRowHandle(const BasicRow<U>&) noexcept;
+
+    template <class U>
+    BasicRowHandle(const BasicRowHandle<U>&) noexcept;
+
+private:
+    BasicTableRef<T> m_table; // nullptr if detached.
+    size_t m_row_ndx = 0;     // Undefined if detached.
+    uint_fast64_t m_row_index_version = 0;
+
+    void attach(T*, size_t row_ndx) noexcept;
+
+    T* impl_get_table() const noexcept;
+    size_t impl_get_row_ndx() const noexcept;
+    void impl_detach() noexcept;
+
+    // Make impl_get_table(), impl_get_row_ndx(), and impl_detach() accessible
+    // from RowFuncs.
+    friend class RowFuncs<T, BasicRowHandle<T>>;
+
+    // Make m_table and m_row_ndx accessible from BasicRowHandle(const
+    // BasicRowHandle<U>&) for any U.
+    template <class>
+    friend class BasicRowHandle;
+};
+
+typedef BasicRowHandle<Table> RowHandle;
+typedef BasicRowHandle<const Table> ConstRowHandle;
+
+
 // Implementation
 
 template <class T, class R>
@@ -857,6 +934,62 @@ inline size_t BasicRow<T>::impl_get_row_ndx() const noexcept
     return m_row_ndx;
 }
 
+
+template <class T>
+template <class U>
+inline BasicRowHandle<T>::BasicRowHandle(BasicRowExpr<U> expr) noexcept
+{
+    T* expr_table = expr.m_table; // Check that pointer types are compatible
+    attach(expr_table, expr.m_row_ndx);
+}
+
+template <class T>
+template <class U>
+inline BasicRowHandle<T>::BasicRowHandle(const BasicRow<U>& row) noexcept
+{
+    T* row_table = row.m_table.get(); // Check that pointer types are compatible
+    attach(row_table, row.m_row_ndx);
+}
+
+template <class T>
+template <class U>
+inline BasicRowHandle<T>::BasicRowHandle(const BasicRowHandle<U>& handle) noexcept
+{
+    T* handle_table = handle.impl_get_table(); // Check that pointer types are compatible
+    attach(handle_table, handle.m_row_ndx);
+}
+
+template <class T>
+inline void BasicRowHandle<T>::attach(T* table, size_t row_ndx) noexcept
+{
+    if (table) {
+        m_table.reset(table);
+        m_row_ndx = row_ndx;
+        m_row_index_version = table->m_row_index_version;
+    }
+}
+
+template <class T>
+inline T* BasicRowHandle<T>::impl_get_table() const noexcept
+{
+    T* table = m_table.get();
+    if (table && table->is_attached() && table->m_row_index_version == m_row_index_version)
+        return table;
+    return nullptr;
+}
+
+template <class T>
+inline size_t BasicRowHandle<T>::impl_get_row_ndx() const noexcept
+{
+    return m_row_ndx;
+}
+
+template <class T>
+inline void BasicRowHandle<T>::impl_detach() noexcept
+{
+    m_table.reset();
+}
+
 } // namespace realm
 
 #endif // REALM_ROW_HPP
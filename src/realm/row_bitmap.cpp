@@ -0,0 +1,447 @@
+/*************************************************************************
+ *
+ * Copyright 2016 Realm Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ **************************************************************************/
+
+#include <realm/row_bitmap.hpp>
+
+#include <algorithm>
+
+#include <realm/array.hpp>
+#include <realm/utilities.hpp>
+
+using namespace realm;
+
+namespace {
+
+// Index of the lowest set bit. `v` must be non-zero.
+inline size_t lowest_set_bit(uint64_t v) noexcept
+{
+#if defined(__GNUC__)
+    return size_t(__builtin_ctzll(v));
+#elif defined(_WIN32) && defined(REALM_PTR_64)
+    unsigned long index = 0;
+    _BitScanForward64(&index, v);
+    return size_t(index);
+#else
+    size_t r = 0;
+    while ((v & 1) == 0) {
+        v >>= 1;
+        ++r;
+    }
+    return r;
+#endif
+}
+
+// Index of the highest set bit. `v` must be non-zero.
+inline size_t highest_set_bit(uint64_t v) noexcept
+{
+#if defined(__GNUC__)
+    return size_t(63 - __builtin_clzll(v));
+#elif defined(_WIN32) && defined(REALM_PTR_64)
+    unsigned long index = 0;
+    _BitScanReverse64(&index, v);
+    return size_t(index);
+#else
+    size_t r = 63;
+    while ((v >> r) == 0)
+        --r;
+    return r;
+#endif
+}
+
+inline size_t popcount(uint64_t v) noexcept
+{
+    return size_t(fast_popcount64(int64_t(v)));
+}
+
+} // anonymous namespace
+
+
+bool RowBitmap::Chunk::contains(size_t offset) const noexcept
+{
+    if (is_bitset())
+        return (bits[offset / 64] >> (offset % 64)) & 1;
+    return std::binary_search(array.begin(), array.end(), uint16_t(offset));
+}
+
+size_t RowBitmap::Chunk::rank(size_t offset) const noexcept
+{
+    if (!is_bitset())
+        return std::lower_bound(array.begin(), array.end(), offset) - array.begin();
+
+    size_t word_ndx = offset / 64;
+    size_t block_begin = word_ndx - word_ndx % block_words;
+    size_t result = blocks[word_ndx / block_words];
+    for (size_t i = block_begin; i < word_ndx; ++i)
+        result += popcount(bits[i]);
+    if (size_t bit = offset % 64)
+        result += popcount(bits[word_ndx] & ((uint64_t(1) << bit) - 1));
+    return result;
+}
+
+size_t RowBitmap::Chunk::select(size_t ndx) const noexcept
+{
+    REALM_ASSERT_DEBUG(ndx < count);
+    if (!is_bitset())
+        return array[ndx];
+
+    size_t block_ndx = std::upper_bound(blocks.begin(), blocks.end(), ndx) - blocks.begin() - 1;
+    ndx -= blocks[block_ndx];
+    for (size_t i = block_ndx * block_words; i < bitset_words; ++i) {
+        uint64_t word = bits[i];
+        size_t n = popcount(word);
+        if (ndx < n) {
+            for (; ndx > 0; --ndx)
+                word &= word - 1; // Clear lowest set bit
+            return i * 64 + lowest_set_bit(word);
+        }
+        ndx -= n;
+    }
+    REALM_UNREACHABLE();
+}
+
+size_t RowBitmap::Chunk::next(size_t offset) const noexcept
+{
+    REALM_ASSERT_DEBUG(is_bitset());
+    if (offset >= chunk_size)
+        return chunk_size;
+    size_t word_ndx = offset / 64;
+    uint64_t word = bits[word_ndx] & (~uint64_t(0) << (offset % 64));
+    for (;;) {
+        if (word != 0)
+            return word_ndx * 64 + lowest_set_bit(word);
+        if (++word_ndx == bitset_words)
+            return chunk_size;
+        word = bits[word_ndx];
+    }
+}
+
+// The greatest member offset that is less than, or equal to `offset`, or
+// `chunk_size` if there is none.
+size_t RowBitmap::Chunk::prev(size_t offset) const noexcept
+{
+    REALM_ASSERT_DEBUG(is_bitset() && offset < chunk_size);
+    size_t word_ndx = offset / 64;
+    uint64_t word = bits[word_ndx] & (~uint64_t(0) >> (63 - offset % 64));
+    for (;;) {
+        if (word != 0)
+            return word_ndx * 64 + highest_set_bit(word);
+        if (word_ndx-- == 0)
+            return chunk_size;
+        word = bits[word_ndx];
+    }
+}
+
+// The iterator position of the last member
+size_t RowBitmap::Chunk::last() const noexcept
+{
+    REALM_ASSERT_DEBUG(count != 0);
+    return is_bitset() ? prev(chunk_size - 1) : array.size() - 1;
+}
+
+bool RowBitmap::Chunk::add(size_t offset)
+{
+    if (is_bitset()) {
+        uint64_t& word = bits[offset / 64];
+        uint64_t mask = uint64_t(1) << (offset % 64);
+        if (word & mask)
+            return false;
+        word |= mask;
+        ++count;
+        for (size_t i = offset / (64 * block_words) + 1; i < bitset_blocks; ++i)
+            ++blocks[i];
+        return true;
+    }
+
+    if (array.empty() || array.back() < offset) {
+        array.push_back(uint16_t(offset)); // Throws
+    }
+    else {
+        auto i = std::lower_bound(array.begin(), array.end(), offset);
+        if (*i == offset)
+            return false;
+        array.insert(i, uint16_t(offset)); // Throws
+    }
+    ++count;
+    if (count > max_array_size)
+        optimize(); // Throws
+    return true;
+}
+
+void RowBitmap::Chunk::add_range(size_t begin, size_t end)
+{
+    REALM_ASSERT_DEBUG(begin <= end && end <= chunk_size);
+    if (!is_bitset() && count + (end - begin) <= max_array_size) {
+        for (size_t i = begin; i < end; ++i)
+            add(i); // Throws
+        return;
+    }
+
+    if (!is_bitset())
+        to_bitset(); // Throws
+    for (size_t i = begin; i < end;) {
+        size_t bit = i % 64;
+        size_t n = std::min(end - i, 64 - bit);
+        uint64_t mask = (n == 64 ? ~uint64_t(0) : ((uint64_t(1) << n) - 1)) << bit;
+        bits[i / 64] |= mask;
+        i += n;
+    }
+    update_blocks();
+}
+
+// A dense chunk is kept as a bitset until it runs out of members, since
+// switching back to an array would require allocating.
+bool RowBitmap::Chunk::remove(size_t offset) noexcept
+{
+    if (is_bitset()) {
+        uint64_t& word = bits[offset / 64];
+        uint64_t mask = uint64_t(1) << (offset % 64);
+        if ((word & mask) == 0)
+            return false;
+        word &= ~mask;
+        --count;
+        for (size_t i = offset / (64 * block_words) + 1; i < bitset_blocks; ++i)
+            --blocks[i];
+        return true;
+    }
+
+    auto i = std::lower_bound(array.begin(), array.end(), offset);
+    if (i == array.end() || *i != offset)
+        return false;
+    array.erase(i);
+    --count;
+    return true;
+}
+
+// Choose the cheapest representation for the current number of members, and
+// recompute `count` from the contents.
+void RowBitmap::Chunk::optimize()
+{
+    if (!is_bitset()) {
+        count = array.size();
+        if (count > max_array_size)
+            to_bitset(); // Throws
+        return;
+    }
+
+    update_blocks();
+    if (count > max_array_size)
+        return;
+    array.reserve(count); // Throws
+    for (size_t offset = next(0); offset < chunk_size; offset = next(offset + 1))
+        array.push_back(uint16_t(offset));
+    bits.clear();
+    bits.shrink_to_fit();
+    blocks.clear();
+    blocks.shrink_to_fit();
+}
+
+void RowBitmap::Chunk::to_bitset()
+{
+    REALM_ASSERT_DEBUG(!is_bitset());
+    std::vector<uint64_t> new_bits(bitset_words);      // Throws
+    std::vector<uint16_t> new_blocks(bitset_blocks); // Throws
+    for (uint16_t offset : array)
+        new_bits[offset / 64] |= uint64_t(1) << (offset % 64);
+    bits = std::move(new_bits);
+    blocks = std::move(new_blocks);
+    array.clear();
+    array.shrink_to_fit();
+    update_blocks();
+}
+
+// Recompute `count` and the block index of a dense chunk
+void RowBitmap::Chunk::update_blocks() noexcept
+{
+    REALM_ASSERT_DEBUG(is_bitset());
+    size_t total = 0;
+    for (size_t i = 0; i < bitset_words; ++i) {
+        if (i % block_words == 0)
+            blocks[i / block_words] = uint16_t(total);
+        total += popcount(bits[i]);
+    }
+    count = total;
+}
+
+
+size_t RowBitmap::find_chunk(size_t key) const noexcept
+{
+    auto i = std::lower_bound(m_chunks.begin(), m_chunks.end(), key,
+                              [](const Chunk& chunk, size_t k) { return chunk.key < k; });
+    return i - m_chunks.begin();
+}
+
+RowBitmap::Chunk& RowBitmap::get_chunk(size_t key)
+{
+    if (m_chunks.empty() || m_chunks.back().key < key) {
+        m_offsets.reserve(m_chunks.size() + 1); // Throws
+        m_chunks.emplace_back();                // Throws
+        m_offsets.push_back(m_size);
+        m_chunks.back().key = key;
+        return m_chunks.back();
+    }
+    size_t ndx = find_chunk(key);
+    if (m_chunks[ndx].key != key) {
+        Chunk chunk;
+        chunk.key = key;
+        size_t offset = m_offsets[ndx];
+        m_offsets.reserve(m_chunks.size() + 1);                    // Throws
+        m_chunks.insert(m_chunks.begin() + ndx, std::move(chunk)); // Throws
+        m_offsets.insert(m_offsets.begin() + ndx, offset);
+    }
+    return m_chunks[ndx];
+}
+
+void RowBitmap::update_offsets() noexcept
+{
+    // Callers reserve capacity before adding chunks, so this never allocates
+    m_offsets.resize(m_chunks.size());
+    size_t total = 0;
+    for (size_t i = 0; i < m_chunks.size(); ++i) {
+        m_offsets[i] = total;
+        total += m_chunks[i].count;
+    }
+    m_size = total;
+}
+
+void RowBitmap::add(size_t row_ndx)
+{
+    Chunk& chunk = get_chunk(row_ndx >> chunk_bits); // Throws
+    if (chunk.add(row_ndx & (chunk_size - 1))) {     // Throws
+        ++m_size;
+        size_t ndx = &chunk - m_chunks.data();
+        for (size_t i = ndx + 1; i < m_offsets.size(); ++i)
+            ++m_offsets[i];
+    }
+}
+
+void RowBitmap::add_range(size_t begin, size_t end)
+{
+    while (begin < end) {
+        size_t key = begin >> chunk_bits;
+        size_t chunk_end = std::min(end, (key + 1) << chunk_bits);
+        Chunk& chunk = get_chunk(key); // Throws
+        chunk.add_range(begin & (chunk_size - 1), chunk_end - (key << chunk_bits)); // Throws
+        begin = chunk_end;
+    }
+    update_offsets();
+}
+
+void RowBitmap::remove(size_t row_ndx) noexcept
+{
+    size_t key = row_ndx >> chunk_bits;
+    size_t ndx = find_chunk(key);
+    if (ndx == m_chunks.size() || m_chunks[ndx].key != key)
+        return;
+    if (!m_chunks[ndx].remove(row_ndx & (chunk_size - 1)))
+        return;
+    if (m_chunks[ndx].count == 0) {
+        m_chunks.erase(m_chunks.begin() + ndx);
+        update_offsets();
+        return;
+    }
+    --m_size;
+    for (size_t i = ndx + 1; i < m_offsets.size(); ++i)
+        --m_offsets[i];
+}
+
+void RowBitmap::clear() noexcept
+{
+    m_chunks.clear();
+    m_offsets.clear();
+    m_size = 0;
+}
+
+bool RowBitmap::contains(size_t row_ndx) const noexcept
+{
+    size_t key = row_ndx >> chunk_bits;
+    size_t ndx = find_chunk(key);
+    return ndx < m_chunks.size() && m_chunks[ndx].key == key && m_chunks[ndx].contains(row_ndx & (chunk_size - 1));
+}
+
+size_t RowBitmap::rank(size_t row_ndx) const noexcept
+{
+    size_t key = row_ndx >> chunk_bits;
+    size_t ndx = find_chunk(key);
+    if (ndx == m_chunks.size())
+        return m_size;
+    if (m_chunks[ndx].key != key)
+        return m_offsets[ndx];
+    return m_offsets[ndx] + m_chunks[ndx].rank(row_ndx & (chunk_size - 1));
+}
+
+size_t RowBitmap::find(size_t row_ndx) const noexcept
+{
+    return contains(row_ndx) ? rank(row_ndx) : not_found;
+}
+
+RowBitmap::const_iterator RowBitmap::select(size_t ndx) const noexcept
+{
+    if (ndx >= m_size)
+        return end();
+    size_t chunk_ndx = std::upper_bound(m_offsets.begin(), m_offsets.end(), ndx) - m_offsets.begin() - 1;
+    const Chunk& chunk = m_chunks[chunk_ndx];
+    size_t ndx_in_chunk = ndx - m_offsets[chunk_ndx];
+    return const_iterator(this, chunk_ndx, chunk.is_bitset() ? chunk.select(ndx_in_chunk) : ndx_in_chunk);
+}
+
+bool RowBitmap::operator==(const RowBitmap& other) const noexcept
+{
+    return m_size == other.m_size && std::equal(begin(), end(), other.begin());
+}
+
+size_t RowBitmap::memory_usage() const noexcept
+{
+    size_t result = m_chunks.capacity() * sizeof(Chunk) + m_offsets.capacity() * sizeof(size_t);
+    for (const Chunk& chunk : m_chunks)
+        result += (chunk.array.capacity() + chunk.blocks.capacity()) * sizeof(uint16_t) +
+                  chunk.bits.capacity() * sizeof(uint64_t);
+    return result;
+}
+
+void RowBitmap::verify() const
+{
+    REALM_ASSERT(m_offsets.size() == m_chunks.size());
+    size_t total = 0;
+    for (size_t i = 0; i < m_chunks.size(); ++i) {
+        const Chunk& chunk = m_chunks[i];
+        REALM_ASSERT(i == 0 || m_chunks[i - 1].key < chunk.key);
+        REALM_ASSERT(m_offsets[i] == total);
+        REALM_ASSERT(chunk.count != 0);
+        if (chunk.is_bitset()) {
+            REALM_ASSERT(chunk.array.empty());
+            REALM_ASSERT(chunk.bits.size() == bitset_words);
+            REALM_ASSERT(chunk.blocks.size() == bitset_blocks);
+            size_t count = 0;
+            for (size_t w = 0; w < bitset_words; ++w) {
+                if (w % block_words == 0)
+                    REALM_ASSERT(chunk.blocks[w / block_words] == count);
+                count += popcount(chunk.bits[w]);
+            }
+            REALM_ASSERT(count == chunk.count);
+        }
+        else {
+            REALM_ASSERT(chunk.array.size() == chunk.count);
+            auto not_ascending = [](uint16_t a, uint16_t b) { return a >= b; };
+            static_cast<void>(not_ascending);
+            REALM_ASSERT(std::adjacent_find(chunk.array.begin(), chunk.array.end(), not_ascending) ==
+                         chunk.array.end());
+        }
+        total += chunk.count;
+    }
+    REALM_ASSERT(total == m_size);
+}
@@ -0,0 +1,266 @@
+/*************************************************************************
+ *
+ * Copyright 2016 Realm Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ **************************************************************************/
+
+#ifndef REALM_ROW_BITMAP_HPP
+#define REALM_ROW_BITMAP_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <vector>
+
+namespace realm {
+
+/// A compressed set of row indexes.
+///
+/// The layout follows the Roaring bitmap scheme: the row index space is split
+/// into chunks of 2^16 rows, and each non-empty chunk is stored either as a
+/// sorted array of 16-bit offsets (when it has few members) or as a bitset of
+/// 2^16 bits (when it is dense). A dense query result therefore costs about
+/// one bit per row of the searched range, rather than a full integer per
+/// match.
+///
+/// Iteration visits the members in ascending (or descending) order and decodes
+/// the chunks lazily, one at a time. Positional lookup (select()) and its
+/// inverse (rank()) are logarithmic in the number of chunks. Within a dense
+/// chunk they use a cumulative count per block of words, so that they never
+/// have to look at more than one block.
+class RowBitmap {
+public:
+    class const_iterator;
+
+    /// Rows are grouped into chunks of this many consecutive row indexes.
+    static const size_t chunk_size = size_t(1) << 16;
+
+    RowBitmap() noexcept;
+
+    /// Add the specified row to the set. Adding rows in ascending order is the
+    /// fast path.
+    void add(size_t row_ndx);
+
+    /// Add all rows in the range `[begin, end)` to the set.
+    void add_range(size_t begin, size_t end);
+
+    /// Remove the specified row from the set, if it is a member.
+    void remove(size_t row_ndx) noexcept;
+
+    void clear() noexcept;
+
+    bool contains(size_t row_ndx) const noexcept;
+
+    /// The number of rows in the set.
+    size_t size() const noexcept;
+    bool empty() const noexcept;
+
+    /// The number of rows in the set that are less than `row_ndx`.
+    size_t rank(size_t row_ndx) const noexcept;
+
+    /// The position of the specified row in the ascending sequence of members,
+    /// or `realm::not_found` if it is not a member.
+    size_t find(size_t row_ndx) const noexcept;
+
+    /// Returns an iterator pointing to the member at the specified position in
+    /// the ascending sequence of members, or end() if `ndx >= size()`.
+    const_iterator select(size_t ndx) const noexcept;
+
+    const_iterator begin() const noexcept;
+    const_iterator end() const noexcept;
+
+    bool operator==(const RowBitmap&) const noexcept;
+    bool operator!=(const RowBitmap&) const noexcept;
+
+    /// An estimate of the number of bytes of heap memory used by this set.
+    size_t memory_usage() const noexcept;
+
+    void verify() const;
+
+private:
+    static const size_t chunk_bits = 16;
+    static const size_t bitset_words = chunk_size / 64;
+    // Number of words in a dense chunk covered by one entry of its block index
+    static const size_t block_words = 8;
+    static const size_t bitset_blocks = bitset_words / block_words;
+    // A chunk with more members than this uses less memory as a bitset
+    static const size_t max_array_size = 4096;
+
+    struct Chunk {
+        size_t key = 0;              // Row index shifted down by `chunk_bits`
+        size_t count = 0;            // Number of members
+        std::vector<uint16_t> array; // Sorted offsets, used while sparse
+        std::vector<uint64_t> bits;  // `bitset_words` words, used when dense
+        // Used when dense: blocks[i] is the number of members in the words
+        // preceding word `i * block_words`
+        std::vector<uint16_t> blocks;
+
+        bool is_bitset() const noexcept
+        {
+            return !bits.empty();
+        }
+        bool contains(size_t offset) const noexcept;
+        size_t rank(size_t offset) const noexcept;
+        size_t select(size_t ndx) const noexcept;
+        size_t next(size_t offset) const noexcept;
+        size_t prev(size_t offset) const noexcept;
+        size_t last() const noexcept;
+        bool add(size_t offset);
+        void add_range(size_t begin, size_t end);
+        bool remove(size_t offset) noexcept;
+        void optimize();
+        void to_bitset();
+        void update_blocks() noexcept;
+    };
+
+    std::vector<Chunk> m_chunks;
+    // m_offsets[i] is the number of members in the chunks preceding chunk i
+    std::vector<size_t> m_offsets;
+    size_t m_size;
+
+    size_t find_chunk(size_t key) const noexcept;
+    Chunk& get_chunk(size_t key);
+    void update_offsets() noexcept;
+
+    friend class const_iterator;
+};
+
+
+/// A bidirectional iterator over the members of a RowBitmap in ascending
+/// order. A chunk is only decoded as the iterator reaches it.
+class RowBitmap::const_iterator {
+public:
+    using iterator_category = std::bidirectional_iterator_tag;
+    using value_type = size_t;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const size_t*;
+    using reference = size_t;
+
+    const_iterator() noexcept = default;
+
+    size_t operator*() const noexcept;
+    const_iterator& operator++() noexcept;
+    const_iterator operator++(int) noexcept;
+    const_iterator& operator--() noexcept;
+
+    bool operator==(const const_iterator& other) const noexcept
+    {
+        return m_chunk == other.m_chunk && m_pos == other.m_pos;
+    }
+    bool operator!=(const const_iterator& other) const noexcept
+    {
+        return !(*this == other);
+    }
+
+private:
+    const RowBitmap* m_bitmap = nullptr;
+    size_t m_chunk = 0;
+    // Index into the array of a sparse chunk, or bit offset in a dense chunk
+    size_t m_pos = 0;
+
+    const_iterator(const RowBitmap* bitmap, size_t chunk, size_t pos) noexcept
+        : m_bitmap(bitmap)
+        , m_chunk(chunk)
+        , m_pos(pos)
+    {
+    }
+
+    friend class RowBitmap;
+};
+
+
+// Implementation:
+
+inline RowBitmap::RowBitmap() noexcept
+    : m_size(0)
+{
+}
+
+inline size_t RowBitmap::size() const noexcept
+{
+    return m_size;
+}
+
+inline bool RowBitmap::empty() const noexcept
+{
+    return m_size == 0;
+}
+
+inline RowBitmap::const_iterator RowBitmap::begin() const noexcept
+{
+    if (m_chunks.empty())
+        return end();
+    const Chunk& chunk = m_chunks.front();
+    return const_iterator(this, 0, chunk.is_bitset() ? chunk.next(0) : 0);
+}
+
+inline RowBitmap::const_iterator RowBitmap::end() const noexcept
+{
+    return const_iterator(this, m_chunks.size(), 0);
+}
+
+inline bool RowBitmap::operator!=(const RowBitmap& other) const noexcept
+{
+    return !(*this == other);
+}
+
+inline size_t RowBitmap::const_iterator::operator*() const noexcept
+{
+    const Chunk& chunk = m_bitmap->m_chunks[m_chunk];
+    size_t offset = chunk.is_bitset() ? m_pos : chunk.array[m_pos];
+    return (chunk.key << chunk_bits) | offset;
+}
+
+inline RowBitmap::const_iterator& RowBitmap::const_iterator::operator++() noexcept
+{
+    const Chunk& chunk = m_bitmap->m_chunks[m_chunk];
+    size_t pos = chunk.is_bitset() ? chunk.next(m_pos + 1) : m_pos + 1;
+    size_t end = chunk.is_bitset() ? chunk_size : chunk.array.size();
+    if (pos < end) {
+        m_pos = pos;
+        return *this;
+    }
+    ++m_chunk;
+    m_pos = 0;
+    if (m_chunk < m_bitmap->m_chunks.size() && m_bitmap->m_chunks[m_chunk].is_bitset())
+        m_pos = m_bitmap->m_chunks[m_chunk].next(0);
+    return *this;
+}
+
+inline RowBitmap::const_iterator RowBitmap::const_iterator::operator++(int) noexcept
+{
+    const_iterator tmp = *this;
+    ++*this;
+    return tmp;
+}
+
+inline RowBitmap::const_iterator& RowBitmap::const_iterator::operator--() noexcept
+{
+    if (m_chunk < m_bitmap->m_chunks.size() && m_pos > 0) {
+        const Chunk& chunk = m_bitmap->m_chunks[m_chunk];
+        size_t pos = chunk.is_bitset() ? chunk.prev(m_pos - 1) : m_pos - 1;
+        if (pos != chunk_size) {
+            m_pos = pos;
+            return *this;
+        }
+    }
+    --m_chunk;
+    m_pos = m_bitmap->m_chunks[m_chunk].last();
+    return *this;
+}
+
+} // namespace realm
+
+#endif // REALM_ROW_BITMAP_HPP
@@ -18,6 +18,7 @@
 
 #include <limits>
 #include <stdexcept>
+#include <unordered_map>
 
 #ifdef REALM_DEBUG
 #include <iostream>
@@ -40,6 +41,8 @@
 #include <realm/column_link.hpp>
 #include <realm/column_linklist.hpp>
 #include <realm/column_backlink.hpp>
+#include <realm/column_timestamp.hpp>
+#include <realm/impl/column_reader.hpp>
 #include <realm/index_string.hpp>
 #include <realm/group.hpp>
 #include <realm/link_view.hpp>
@@ -1259,6 +1262,7 @@ void Table::do_unregister_row_accessor(RowBase* row) const noexcept
 void Table::discard_row_accessors() noexcept
 {
     LockGuard lock(m_accessor_mutex);
+    ++m_row_index_version;
     for (RowBase* row = m_row_accessors; row; row = row->m_next)
         row->m_table.reset(); // Detach
     m_row_accessors = nullptr;
@@ -2994,6 +2998,138 @@ util::Optional<int64_t> Table::get(size_t col_ndx, size_t ndx) const noexcept
     return col.get(ndx);
 }
 
+namespace {
+
+// Row accessors for the batch getters
+struct RowRange {
+    size_t begin;
+    size_t operator()(size_t i) const noexcept
+    {
+        return begin + i;
+    }
+};
+
+struct RowList {
+    const size_t* rows;
+    size_t operator()(size_t i) const noexcept
+    {
+        return rows[i];
+    }
+};
+
+template <class ColType, class RowAt, class T, class Convert>
+void read_rows(const ColType& col, size_t num_rows, RowAt row_at, T* out, Convert convert) noexcept
+{
+    ColumnReader<ColType> reader(col);
+    for (size_t i = 0; i < num_rows; ++i)
+        out[i] = convert(reader.get(row_at(i)));
+}
+
+template <class ColType, class RowAt, class T>
+void read_rows(const ColType& col, size_t num_rows, RowAt row_at, T* out) noexcept
+{
+    read_rows(col, num_rows, row_at, out, [](T v) { return v; });
+}
+
+} // anonymous namespace
+
+template <class RowAt>
+void Table::read_ints(size_t col_ndx, size_t num_rows, RowAt row_at, int64_t* out) const noexcept
+{
+    REALM_ASSERT_3(col_ndx, <, get_column_count());
+    REALM_ASSERT_3(get_real_column_type(col_ndx), ==, col_type_Int);
+
+    if (is_nullable(col_ndx)) {
+        const IntNullColumn& col = get_column<IntNullColumn, col_type_Int>(col_ndx);
+        read_rows(col, num_rows, row_at, out, [](util::Optional<int64_t> v) { return v.value_or(0); });
+    }
+    else {
+        read_rows(get_column<IntegerColumn, col_type_Int>(col_ndx), num_rows, row_at, out);
+    }
+}
+
+template <class RowAt>
+void Table::read_doubles(size_t col_ndx, size_t num_rows, RowAt row_at, double* out) const noexcept
+{
+    REALM_ASSERT_3(col_ndx, <, get_column_count());
+    REALM_ASSERT_3(get_real_column_type(col_ndx), ==, col_type_Double);
+
+    const DoubleColumn& col = get_column<DoubleColumn, col_type_Double>(col_ndx);
+    read_rows(col, num_rows, row_at, out, [](double v) { return null::is_null_float(v) ? 0.0 : v; });
+}
+
+template <class RowAt>
+void Table::read_timestamps(size_t col_ndx, size_t num_rows, RowAt row_at, Timestamp* out) const noexcept
+{
+    REALM_ASSERT_3(col_ndx, <, get_column_count());
+    REALM_ASSERT_3(get_real_column_type(col_ndx), ==, col_type_Timestamp);
+
+    read_rows(get_column<TimestampColumn, col_type_Timestamp>(col_ndx), num_rows, row_at, out);
+}
+
+template <class RowAt>
+void Table::read_strings(size_t col_ndx, size_t num_rows, RowAt row_at, StringData* out) const noexcept
+{
+    REALM_ASSERT_3(col_ndx, <, get_column_count());
+
+    ColumnType type = get_real_column_type(col_ndx);
+    if (type == col_type_StringEnum) {
+        read_rows(get_column_string_enum(col_ndx), num_rows, row_at, out);
+        return;
+    }
+    REALM_ASSERT_3(type, ==, col_type_String);
+
+    read_rows(get_column_string(col_ndx), num_rows, row_at, out);
+}
+
+void Table::get_ints(size_t col_ndx, size_t begin, size_t end, int64_t* out) const noexcept
+{
+    REALM_ASSERT_3(begin, <=, end);
+    REALM_ASSERT_3(end, <=, m_size);
+    read_ints(col_ndx, end - begin, RowRange{begin}, out);
+}
+
+void Table::get_doubles(size_t col_ndx, size_t begin, size_t end, double* out) const noexcept
+{
+    REALM_ASSERT_3(begin, <=, end);
+    REALM_ASSERT_3(end, <=, m_size);
+    read_doubles(col_ndx, end - begin, RowRange{begin}, out);
+}
+
+void Table::get_timestamps(size_t col_ndx, size_t begin, size_t end, Timestamp* out) const noexcept
+{
+    REALM_ASSERT_3(begin, <=, end);
+    REALM_ASSERT_3(end, <=, m_size);
+    read_timestamps(col_ndx, end - begin, RowRange{begin}, out);
+}
+
+void Table::get_strings(size_t col_ndx, size_t begin, size_t end, StringData* out) const noexcept
+{
+    REALM_ASSERT_3(begin, <=, end);
+    REALM_ASSERT_3(end, <=, m_size);
+    read_strings(col_ndx, end - begin, RowRange{begin}, out);
+}
+
+void Table::gather_ints(size_t col_ndx, const size_t* rows, size_t num_rows, int64_t* out) const noexcept
+{
+    read_ints(col_ndx, num_rows, RowList{rows}, out);
+}
+
+void Table::gather_doubles(size_t col_ndx, const size_t* rows, size_t num_rows, double* out) const noexcept
+{
+    read_doubles(col_ndx, num_rows, RowList{rows}, out);
+}
+
+void Table::gather_timestamps(size_t col_ndx, const size_t* rows, size_t num_rows, Timestamp* out) const noexcept
+{
+    read_timestamps(col_ndx, num_rows, RowList{rows}, out);
+}
+
+void Table::gather_strings(size_t col_ndx, const size_t* rows, size_t num_rows, StringData* out) const noexcept
+{
+    read_strings(col_ndx, num_rows, RowList{rows}, out);
+}
+
 template <>
 OldDateTime Table::get(size_t col_ndx, size_t ndx) const noexcept
 {
@@ -4746,6 +4882,433 @@ void Table::aggregate(size_t group_by_column, size_t aggr_column, AggrType op, T
 }
 
 
+namespace {
+
+// The hash table that maps the keys of the groups of a grouped aggregate to
+// the index of the group. A key is a fixed number of words, and the keys of
+// all groups are stored back to back, in order of the group indexes.
+class GroupByHashTable {
+public:
+    explicit GroupByHashTable(size_t key_size)
+        : m_key_size(key_size)
+        , m_slots(16, 0) // Throws
+    {
+    }
+
+    size_t size() const noexcept
+    {
+        return m_num_groups;
+    }
+
+    // Returns the index of the group with the specified key, adding a new
+    // group if there is none.
+    size_t find_or_add(const int64_t* key)
+    {
+        size_t mask = m_slots.size() - 1;
+        size_t i = hash(key) & mask;
+        while (size_t slot = m_slots[i]) {
+            const int64_t* other = &m_keys[(slot - 1) * m_key_size];
+            if (std::equal(key, key + m_key_size, other))
+                return slot - 1;
+            i = (i + 1) & mask;
+        }
+
+        m_keys.insert(m_keys.end(), key, key + m_key_size); // Throws
+        m_slots[i] = ++m_num_groups;
+        if (m_num_groups * 2 > m_slots.size())
+            grow(); // Throws
+        return m_num_groups - 1;
+    }
+
+private:
+    const size_t m_key_size;
+    size_t m_num_groups = 0;
+    std::vector<int64_t> m_keys;
+    // Group index plus one, or zero for unused slots. The number of slots is a
+    // power of two, and at most half of them are in use.
+    std::vector<size_t> m_slots;
+
+    size_t hash(const int64_t* key) const noexcept
+    {
+        uint_fast64_t h = 0;
+        for (size_t i = 0; i < m_key_size; ++i)
+            h = (h ^ uint_fast64_t(key[i])) * 0x9E3779B97F4A7C15ULL;
+        return size_t(h ^ (h >> 32));
+    }
+
+    void grow()
+    {
+        std::vector<size_t> slots(m_slots.size() * 2, 0); // Throws
+        size_t mask = slots.size() - 1;
+        for (size_t group = 0; group < m_num_groups; ++group) {
+            size_t i = hash(&m_keys[group * m_key_size]) & mask;
+            while (slots[i])
+                i = (i + 1) & mask;
+            slots[i] = group + 1;
+        }
+        m_slots.swap(slots);
+    }
+};
+
+struct StringDataHash {
+    size_t operator()(StringData str) const noexcept
+    {
+        // FNV-1a
+        uint_fast64_t h = 14695981039346656037ULL;
+        const char* data = str.data();
+        for (size_t i = 0; i < str.size(); ++i)
+            h = (h ^ uint_fast64_t(static_cast<unsigned char>(data[i]))) * 1099511628211ULL;
+        return size_t(h ^ (str.is_null() ? 1 : 0));
+    }
+};
+
+// Reads the key of a group from one of the group-by columns
+struct GroupByKeyColumn {
+    enum class Kind { integer, nullable_integer, string, string_enum, link };
+
+    Kind kind;
+    const ColumnBase* column;
+    // The distinct values of a string column (not enumerated), in order of
+    // first occurrence, and their position in that order
+    std::unordered_map<StringData, int64_t, StringDataHash> string_codes;
+    std::vector<StringData> strings;
+
+    // Number of words of the key
+    size_t key_size() const noexcept
+    {
+        return kind == Kind::nullable_integer ? 2 : 1;
+    }
+
+    void get_key(size_t row_ndx, int64_t* key)
+    {
+        switch (kind) {
+            case Kind::integer:
+                key[0] = static_cast<const IntegerColumn*>(column)->get(row_ndx);
+                return;
+            case Kind::nullable_integer: {
+                util::Optional<int64_t> value = static_cast<const IntNullColumn*>(column)->get(row_ndx);
+                key[0] = value ? 1 : 0;
+                key[1] = value ? *value : 0;
+                return;
+            }
+            case Kind::string: {
+                // Strings are identified by their position among the distinct
+                // strings of the column
+                StringData value = static_cast<const StringColumn*>(column)->get(row_ndx);
+                auto i = string_codes.emplace(value, int64_t(strings.size())).first; // Throws
+                if (size_t(i->second) == strings.size())
+                    strings.push_back(value); // Throws
+                key[0] = i->second;
+                return;
+            }
+            case Kind::string_enum:
+                // Grouping on the index of the enumerated string avoids
+                // decoding it
+                key[0] = static_cast<const StringEnumColumn*>(column)->IntegerColumn::get(row_ndx);
+                return;
+            case Kind::link: {
+                const LinkColumn& links = *static_cast<const LinkColumn*>(column);
+                key[0] = links.is_null_link(row_ndx) ? -1 : int64_t(links.get_link(row_ndx));
+                return;
+            }
+        }
+        REALM_UNREACHABLE();
+    }
+
+    StringData get_string(int64_t code) const noexcept
+    {
+        if (kind == Kind::string_enum)
+            return static_cast<const StringEnumColumn*>(column)->get_keys().get(size_t(code));
+        return strings[size_t(code)];
+    }
+};
+
+// Computes one of the aggregates of a grouped aggregate for all the groups
+struct GroupByAggregateColumn {
+    enum class Kind { count, integer, nullable_integer, floating, doubles };
+
+    struct State {
+        int64_t int_value = 0;
+        double double_value = 0;
+        // Number of rows, or number of non-null values aggregated
+        size_t count = 0;
+    };
+
+    Table::AggrType op;
+    Kind kind;
+    const ColumnBase* column;
+    std::vector<State> states;
+
+    void add(size_t group, size_t row_ndx)
+    {
+        if (group == states.size())
+            states.emplace_back(); // Throws
+        State& state = states[group];
+
+        switch (kind) {
+            case Kind::count:
+                ++state.count;
+                return;
+            case Kind::integer:
+                add_int(state, static_cast<const IntegerColumn*>(column)->get(row_ndx));
+                return;
+            case Kind::nullable_integer: {
+                util::Optional<int64_t> value = static_cast<const IntNullColumn*>(column)->get(row_ndx);
+                if (value)
+                    add_int(state, *value);
+                return;
+            }
+            case Kind::floating: {
+                const FloatColumn& floats = *static_cast<const FloatColumn*>(column);
+                if (!floats.is_null(row_ndx))
+                    add_double(state, floats.get(row_ndx));
+                return;
+            }
+            case Kind::doubles: {
+                const DoubleColumn& doubles = *static_cast<const DoubleColumn*>(column);
+                if (!doubles.is_null(row_ndx))
+                    add_double(state, doubles.get(row_ndx));
+                return;
+            }
+        }
+        REALM_UNREACHABLE();
+    }
+
+    template <class T>
+    void add_value(T& aggregate, size_t& count, T value) noexcept
+    {
+        bool first = (count++ == 0);
+        switch (op) {
+            case Table::aggr_count:
+                return;
+            case Table::aggr_sum:
+            case Table::aggr_avg:
+                aggregate += value;
+                return;
+            case Table::aggr_min:
+                if (first || value < aggregate)
+                    aggregate = value;
+                return;
+            case Table::aggr_max:
+                if (first || value > aggregate)
+                    aggregate = value;
+                return;
+        }
+    }
+
+    void add_int(State& state, int64_t value) noexcept
+    {
+        add_value(state.int_value, state.count, value);
+    }
+
+    void add_double(State& state, double value) noexcept
+    {
+        add_value(state.double_value, state.count, value);
+    }
+};
+
+} // anonymous namespace
+
+// Grouped aggregate method. Experimental! Please do not document method publicly.
+void Table::aggregate(const std::vector<size_t>& group_by_columns, const std::vector<AggrSpec>& aggregates,
+                      Table& result, const IntegerColumn* viewrefs) const
+{
+    REALM_ASSERT(result.is_empty() && result.get_column_count() == 0);
+    using KeyKind = GroupByKeyColumn::Kind;
+    using AggrKind = GroupByAggregateColumn::Kind;
+
+    // Set up the readers of the keys, and add a column to the result for each
+    std::vector<GroupByKeyColumn> keys(group_by_columns.size()); // Throws
+    size_t key_size = 0;
+    for (size_t i = 0; i < keys.size(); ++i) {
+        size_t col_ndx = group_by_columns[i];
+        if (REALM_UNLIKELY(col_ndx >= m_columns.size()))
+            throw LogicError(LogicError::column_index_out_of_range);
+        bool nullable = is_nullable(col_ndx);
+        DataType type = get_column_type(col_ndx);
+        GroupByKeyColumn& key = keys[i];
+        key.column = &get_column_base(col_ndx);
+        switch (get_real_column_type(col_ndx)) {
+            case col_type_Int:
+            case col_type_Bool:
+                key.kind = nullable ? KeyKind::nullable_integer : KeyKind::integer;
+                break;
+            case col_type_String:
+                key.kind = KeyKind::string;
+                break;
+            case col_type_StringEnum:
+                key.kind = KeyKind::string_enum;
+                break;
+            case col_type_Link:
+                key.kind = KeyKind::link;
+                type = type_Int; // The index of the target row
+                nullable = true;
+                break;
+            default:
+                throw LogicError(LogicError::type_mismatch);
+        }
+        key_size += key.key_size();
+        result.add_column(type, get_column_name(col_ndx), nullable); // Throws
+    }
+
+    // Set up the aggregates, and add a column to the result for each
+    std::vector<GroupByAggregateColumn> aggrs(aggregates.size()); // Throws
+    for (size_t i = 0; i < aggrs.size(); ++i) {
+        GroupByAggregateColumn& aggr = aggrs[i];
+        aggr.op = aggregates[i].op;
+        if (aggr.op == aggr_count) {
+            aggr.kind = AggrKind::count;
+            aggr.column = nullptr;
+            result.add_column(type_Int, "COUNT()"); // Throws
+            continue;
+        }
+
+        size_t col_ndx = aggregates[i].column_ndx;
+        if (REALM_UNLIKELY(col_ndx >= m_columns.size()))
+            throw LogicError(LogicError::column_index_out_of_range);
+        DataType type = get_column_type(col_ndx);
+        aggr.column = &get_column_base(col_ndx);
+        switch (type) {
+            case type_Int:
+                aggr.kind = is_nullable(col_ndx) ? AggrKind::nullable_integer : AggrKind::integer;
+                break;
+            case type_Float:
+                aggr.kind = AggrKind::floating;
+                break;
+            case type_Double:
+                aggr.kind = AggrKind::doubles;
+                break;
+            default:
+                throw LogicError(LogicError::type_mismatch);
+        }
+
+        const char* prefix = nullptr;
+        DataType result_type = type;
+        switch (aggr.op) {
+            case aggr_count:
+                REALM_UNREACHABLE();
+            case aggr_sum:
+                prefix = "SUM";
+                result_type = (type == type_Int ? type_Int : type_Double);
+                break;
+            case aggr_avg:
+                prefix = "AVG";
+                result_type = type_Double;
+                break;
+            case aggr_min:
+                prefix = "MIN";
+                break;
+            case aggr_max:
+                prefix = "MAX";
+                break;
+        }
+        std::string name = std::string(prefix) + "(" + std::string(get_column_name(col_ndx)) + ")"; // Throws
+        // Groups with no values have null minimums, maximums and averages
+        bool nullable = (aggr.op != aggr_sum);
+        result.add_column(result_type, name, nullable); // Throws
+    }
+
+    // Gather the groups in one pass over the rows
+    GroupByHashTable groups(key_size); // Throws
+    std::vector<int64_t> key(key_size); // Throws
+    std::vector<size_t> first_rows;
+    auto add_row = [&](size_t row_ndx) {
+        int64_t* k = key.data();
+        for (GroupByKeyColumn& key_column : keys) {
+            key_column.get_key(row_ndx, k); // Throws
+            k += key_column.key_size();
+        }
+        size_t group = groups.find_or_add(key.data()); // Throws
+        if (group == first_rows.size())
+            first_rows.push_back(row_ndx); // Throws
+        for (GroupByAggregateColumn& aggr : aggrs)
+            aggr.add(group, row_ndx); // Throws
+    };
+    if (viewrefs) {
+        for (size_t i = 0, n = viewrefs->size(); i < n; ++i) {
+            int64_t row_ndx = viewrefs->get(i);
+            if (row_ndx >= 0) // Skip detached rows
+                add_row(to_size_t(row_ndx)); // Throws
+        }
+    }
+    else {
+        for (size_t row_ndx = 0, n = size(); row_ndx < n; ++row_ndx)
+            add_row(row_ndx); // Throws
+    }
+
+    // Write out the groups in order of first occurrence
+    size_t num_groups = groups.size();
+    result.add_empty_row(num_groups); // Throws
+    for (size_t group = 0; group < num_groups; ++group) {
+        size_t row_ndx = first_rows[group];
+        for (size_t i = 0; i < keys.size(); ++i) {
+            GroupByKeyColumn& key_column = keys[i];
+            int64_t* k = key.data();
+            key_column.get_key(row_ndx, k); // Throws
+            switch (key_column.kind) {
+                case KeyKind::integer:
+                case KeyKind::nullable_integer:
+                    if (key_column.kind == KeyKind::nullable_integer) {
+                        if (k[0] == 0)
+                            break; // Null
+                        ++k;
+                    }
+                    if (result.get_column_type(i) == type_Bool) {
+                        result.set_bool(i, group, *k != 0); // Throws
+                    }
+                    else {
+                        result.set_int(i, group, *k); // Throws
+                    }
+                    break;
+                case KeyKind::string:
+                case KeyKind::string_enum:
+                    result.set_string(i, group, key_column.get_string(*k)); // Throws
+                    break;
+                case KeyKind::link:
+                    if (*k != -1)
+                        result.set_int(i, group, *k); // Throws
+                    break;
+            }
+        }
+
+        for (size_t i = 0; i < aggrs.size(); ++i) {
+            const GroupByAggregateColumn& aggr = aggrs[i];
+            const GroupByAggregateColumn::State& state = aggr.states[group];
+            size_t col_ndx = keys.size() + i;
+            if (aggr.kind == AggrKind::count) {
+                result.set_int(col_ndx, group, int64_t(state.count)); // Throws
+                continue;
+            }
+            bool is_int = (aggr.kind == AggrKind::integer || aggr.kind == AggrKind::nullable_integer);
+            if (aggr.op == aggr_sum) {
+                if (is_int) {
+                    result.set_int(col_ndx, group, state.int_value); // Throws
+                }
+                else {
+                    result.set_double(col_ndx, group, state.double_value); // Throws
+                }
+                continue;
+            }
+            if (state.count == 0)
+                continue; // Null
+            if (aggr.op == aggr_avg) {
+                double sum = (is_int ? double(state.int_value) : state.double_value);
+                result.set_double(col_ndx, group, sum / double(state.count)); // Throws
+            }
+            else if (is_int) {
+                result.set_int(col_ndx, group, state.int_value); // Throws
+            }
+            else if (aggr.kind == AggrKind::floating) {
+                result.set_float(col_ndx, group, float(state.double_value)); // Throws
+            }
+            else {
+                result.set_double(col_ndx, group, state.double_value); // Throws
+            }
+        }
+    }
+}
+
+
 TableView Table::get_range_view(size_t begin, size_t end)
 {
     REALM_ASSERT(!m_columns.is_attached() || end <= size());
@@ -5934,6 +6497,41 @@ void Table::adj_acc_clear_root_table() noexcept
 }
 
 
+void Table::adj_acc_modify_row(size_t row_ndx) noexcept
+{
+    // This function must assume no more than minimal consistency of the
+    // accessor hierarchy. This means in particular that it cannot access the
+    // underlying node structure. See AccessorConcistencyLevels.
+
+    LockGuard lock(m_accessor_mutex);
+    for (auto& view : m_views) {
+        view->adj_row_acc_modify_row(row_ndx);
+    }
+}
+
+
+void Table::begin_row_change_tracking() noexcept
+{
+    LockGuard lock(m_accessor_mutex);
+    m_tracking_row_changes = true;
+    for (auto& view : m_views) {
+        view->begin_row_changes(m_version);
+    }
+}
+
+
+void Table::end_row_change_tracking(bool schema_changed) noexcept
+{
+    LockGuard lock(m_accessor_mutex);
+    if (!m_tracking_row_changes)
+        return;
+    m_tracking_row_changes = false;
+    for (auto& view : m_views) {
+        view->end_row_changes(m_version, schema_changed);
+    }
+}
+
+
 void Table::adj_acc_clear_nonroot_table() noexcept
 {
     // This function must assume no more than minimal consistency of the
@@ -5954,6 +6552,7 @@ void Table::adj_row_acc_insert_rows(size_t row_ndx, size_t num_rows) noexcept
 
     // Adjust row accessors after insertion of new rows
     LockGuard lock(m_accessor_mutex);
+    ++m_row_index_version;
     for (RowBase* row = m_row_accessors; row; row = row->m_next) {
         if (row->m_row_ndx >= row_ndx)
             row->m_row_ndx += num_rows;
@@ -5974,6 +6573,7 @@ void Table::adj_row_acc_erase_row(size_t row_ndx) noexcept
 
     // Adjust row accessors after removal of a row
     LockGuard lock(m_accessor_mutex);
+    ++m_row_index_version;
     RowBase* row = m_row_accessors;
     while (row) {
         RowBase* next = row->m_next;
@@ -6001,6 +6601,7 @@ void Table::adj_row_acc_swap_rows(size_t row_ndx_1, size_t row_ndx_2) noexcept
 
     // Adjust row accessors after swap
     LockGuard lock(m_accessor_mutex);
+    ++m_row_index_version;
     RowBase* row = m_row_accessors;
     while (row) {
         if (row->m_row_ndx == row_ndx_1) {
@@ -6027,6 +6628,7 @@ void Table::adj_row_acc_move_row(size_t from_ndx, size_t to_ndx) noexcept
 
     // Adjust row accessors after move
     LockGuard lock(m_accessor_mutex);
+    ++m_row_index_version;
     RowBase* row = m_row_accessors;
     while (row) {
         size_t ndx = row->m_row_ndx;
@@ -6053,6 +6655,7 @@ void Table::adj_row_acc_merge_rows(size_t old_row_ndx, size_t new_row_ndx) noexc
     // underlying node structure. See AccessorConsistencyLevels.
 
     LockGuard lock(m_accessor_mutex);
+    ++m_row_index_version;
     RowBase* row = m_row_accessors;
     while (row) {
         if (row->m_row_ndx == old_row_ndx)
@@ -6068,6 +6671,7 @@ void Table::adj_row_acc_move_over(size_t from_row_ndx, size_t to_row_ndx) noexce
     // accessor hierarchy. This means in particular that it cannot access the
     // underlying node structure. See AccessorConsistencyLevels.
     LockGuard lock(m_accessor_mutex);
+    ++m_row_index_version;
     RowBase* row = m_row_accessors;
     while (row) {
         RowBase* next = row->m_next;
@@ -434,6 +434,29 @@ public:
 
     //@}
 
+    //@{
+
+    /// Get the cell values of a range of rows, `[begin, end)`, or of the rows
+    /// given by `rows[0]` to `rows[num_rows - 1]`, into `out`, which must have
+    /// room for a value per row. The values are those that the single cell
+    /// getters above would return, including for nulls, but each leaf of the
+    /// column is looked up only once for all the consecutive rows that it
+    /// holds, instead of once per cell. The strings point into the database,
+    /// and are valid for as long as the string returned by get_string() would
+    /// be.
+    ///
+    /// Will assert if the requested type does not match the column type.
+    void get_ints(size_t column_ndx, size_t begin, size_t end, int64_t* out) const noexcept;
+    void get_doubles(size_t column_ndx, size_t begin, size_t end, double* out) const noexcept;
+    void get_timestamps(size_t column_ndx, size_t begin, size_t end, Timestamp* out) const noexcept;
+    void get_strings(size_t column_ndx, size_t begin, size_t end, StringData* out) const noexcept;
+    void gather_ints(size_t column_ndx, const size_t* rows, size_t num_rows, int64_t* out) const noexcept;
+    void gather_doubles(size_t column_ndx, const size_t* rows, size_t num_rows, double* out) const noexcept;
+    void gather_timestamps(size_t column_ndx, const size_t* rows, size_t num_rows, Timestamp* out) const noexcept;
+    void gather_strings(size_t column_ndx, const size_t* rows, size_t num_rows, StringData* out) const noexcept;
+
+    //@}
+
     /// Return data from position 'pos' and onwards. If the blob is distributed
     /// across multiple arrays, you will only get data from one array. 'pos'
     /// will be updated to be an index to next available data. It will be 0
@@ -702,6 +725,25 @@ public:
     void aggregate(size_t group_by_column, size_t aggr_column, AggrType op, Table& result,
                    const IntegerColumn* viewrefs = nullptr) const;
 
+    // An aggregate of the grouped aggregate method. The column is ignored for aggr_count.
+    struct AggrSpec {
+        AggrType op;
+        size_t column_ndx;
+    };
+
+    // Grouped aggregate method. Experimental! Please do not document method publicly.
+    //
+    // Groups the rows by the values of the group-by columns, which can be
+    // integer, boolean, string and link columns, and computes the aggregates
+    // over integer, float and double columns for each group in a single pass.
+    // `result` must be empty and have no columns. It gets a column for each
+    // group-by column (a link as the index of the target row) followed by a
+    // column for each aggregate, and a row for each group in order of first
+    // occurrence. Null values are skipped by the aggregates, and the minimum,
+    // maximum and average of a group with no values are null.
+    void aggregate(const std::vector<size_t>& group_by_columns, const std::vector<AggrSpec>& aggregates,
+                   Table& result, const IntegerColumn* viewrefs = nullptr) const;
+
     /// Report the current versioning counter for the table. The versioning counter is guaranteed to
     /// change when the contents of the table changes after advance_read() or promote_to_write(), or
     /// immediately after calls to methods which change the table. The term "change" means "change of
@@ -717,6 +759,15 @@ private:
     template <class T>
     TableView find_all(size_t column_ndx, T value);
 
+    template <class RowAt>
+    void read_ints(size_t column_ndx, size_t num_rows, RowAt, int64_t* out) const noexcept;
+    template <class RowAt>
+    void read_doubles(size_t column_ndx, size_t num_rows, RowAt, double* out) const noexcept;
+    template <class RowAt>
+    void read_timestamps(size_t column_ndx, size_t num_rows, RowAt, Timestamp* out) const noexcept;
+    template <class RowAt>
+    void read_strings(size_t column_ndx, size_t num_rows, RowAt, StringData* out) const noexcept;
+
 public:
     //@{
     /// Find the lower/upper bound according to a column that is
@@ -1045,6 +1096,11 @@ private:
     // Points to first bound row accessor, or is null if there are none.
     mutable RowBase* m_row_accessors = nullptr;
 
+    // Changed whenever rows are inserted (other than at the end), removed or
+    // moved, or the row accessors are discarded. Untracked row handles are
+    // valid only while it is unchanged (see BasicRowHandle).
+    uint_fast64_t m_row_index_version = 0;
+
     // Mutex which must be locked any time the row accessor chain or m_views is used
     mutable util::Mutex m_accessor_mutex;
 
@@ -1057,6 +1113,11 @@ private:
 
     mutable uint_fast64_t m_version;
 
+    /// True while Group::advance_transact() replays the transaction logs. Table
+    /// views use this to tell row changes that they are informed of in detail
+    /// from changes made directly through this accessor.
+    bool m_tracking_row_changes = false;
+
     void erase_row(size_t row_ndx, bool is_move_last_over);
     void batch_erase_rows(const IntegerColumn& row_indexes, bool is_move_last_over);
     void do_remove(size_t row_ndx, bool broken_reciprocal_backlinks);
@@ -1475,6 +1536,16 @@ private:
     void adj_acc_move_over(size_t from_row_ndx, size_t to_row_ndx) noexcept;
 
     void adj_acc_clear_root_table() noexcept;
+
+    /// Called by Group::advance_transact() for each instruction that modifies
+    /// the contents of a row.
+    void adj_acc_modify_row(size_t row_ndx) noexcept;
+
+    /// Called by Group::advance_transact() before and after it replays the
+    /// transaction logs, such that attached table views can record which rows
+    /// were changed, and later sync themselves incrementally.
+    void begin_row_change_tracking() noexcept;
+    void end_row_change_tracking(bool schema_changed) noexcept;
     void adj_acc_clear_nonroot_table() noexcept;
     void adj_row_acc_insert_rows(size_t row_ndx, size_t num_rows) noexcept;
     void adj_row_acc_erase_row(size_t row_ndx) noexcept;
@@ -1567,6 +1638,8 @@ private:
     template <class>
     friend class SequentialGetter;
     friend class RowBase;
+    template <class>
+    friend class BasicRowHandle;
     friend class LinksToNode;
     friend class LinkMap;
     friend class LinkView;
@@ -2622,6 +2695,21 @@ public:
         table.adj_acc_clear_root_table();
     }
 
+    static void adj_acc_modify_row(Table& table, size_t row_ndx) noexcept
+    {
+        table.adj_acc_modify_row(row_ndx);
+    }
+
+    static void begin_row_change_tracking(Table& table) noexcept
+    {
+        table.begin_row_change_tracking();
+    }
+
+    static void end_row_change_tracking(Table& table, bool schema_changed) noexcept
+    {
+        table.end_row_change_tracking(schema_changed);
+    }
+
     static void adj_acc_clear_nonroot_table(Table& table) noexcept
     {
         table.adj_acc_clear_nonroot_table();
@@ -21,8 +21,11 @@
 #include <realm/column.hpp>
 #include <realm/column_timestamp.hpp>
 #include <realm/column_tpl.hpp>
+#include <realm/impl/column_reader.hpp>
+#include <realm/impl/destroy_guard.hpp>
 #include <realm/impl/sequential_getter.hpp>
 
+#include <algorithm>
 #include <unordered_set>
 
 using namespace realm;
@@ -46,6 +49,7 @@ TableViewBase::TableViewBase(TableViewBase& src, HandoverPatch& patch, MutableSo
     }
 
     src.m_last_seen_version = util::none; // bring source out-of-sync, now that it has lost its data
+    src.discard_row_changes();
     m_last_seen_version = 0;
     m_start = src.m_start;
     m_end = src.m_end;
@@ -101,8 +105,8 @@ size_t TableViewBase::find_first(size_t column_ndx, T value) const
 {
     check_cookie();
 
-    for (size_t i = 0, num_rows = m_row_indexes.size(); i < num_rows; ++i) {
-        const int64_t real_ndx = m_row_indexes.get(i);
+    for (size_t i = 0, num_rows = size(); i < num_rows; ++i) {
+        const int64_t real_ndx = get_row_index(i);
         if (real_ndx != detached_ref && m_table->get<T>(column_ndx, to_size_t(real_ndx)) == value)
             return i;
     }
@@ -145,7 +149,7 @@ R TableViewBase::aggregate(R (ColType::*aggregateMethod)(size_t, size_t, size_t,
     REALM_ASSERT(m_table);
     REALM_ASSERT(column_ndx < m_table->get_column_count());
 
-    if ((m_row_indexes.size() - m_num_detached_refs) == 0) {
+    if ((size() - m_num_detached_refs) == 0) {
         if (return_ndx) {
             if (function == act_Average)
                 *return_ndx = 0;
@@ -155,7 +159,6 @@ R TableViewBase::aggregate(R (ColType::*aggregateMethod)(size_t, size_t, size_t,
         return 0;
     }
 
-    typedef typename ColTypeTraits::leaf_type ArrType;
     const ColType* column = static_cast<ColType*>(&m_table->get_column_base(column_ndx));
 
     // FIXME: Optimization temporarely removed for stability
@@ -169,27 +172,18 @@ R TableViewBase::aggregate(R (ColType::*aggregateMethod)(size_t, size_t, size_t,
     }
 */
 
-    // Array object instantiation must NOT allocate initial memory (capacity)
-    // with 'new' because it will lead to mem leak. The column keeps ownership
-    // of the payload in array and will free it itself later, so we must not call destroy() on array.
-    ArrType arr(column->get_alloc());
+    // Read the values through the cached leaf, as the rows of the view are
+    // often in ascending order
+    ColumnReader<ColType> reader(*column);
 
-    // FIXME: Speed optimization disabled because we need is_null() which is not available on all leaf types.
-
-/*
-    const ArrType* arrp = nullptr;
-    size_t leaf_start = 0;
-    size_t leaf_end = 0;
-    size_t row_ndx;
-*/
     R res = R{};
-    size_t row = to_size_t(m_row_indexes.get(0));
-    auto first = column->get(row);
+    size_t row = to_size_t(get_row_index(0));
+    auto first = reader.get(row);
 
     if (function == act_Count) {
         res = static_cast<R>((first == count_target ? 1 : 0));
     }
-    else if(!column->is_null(row)) { // cannot just use if(v) on float/double types
+    else if(!reader.is_null(row)) { // cannot just use if(v) on float/double types
         res = static_cast<R>(util::unwrap(first));
         non_nulls++;
         if (return_ndx) {
@@ -197,30 +191,20 @@ R TableViewBase::aggregate(R (ColType::*aggregateMethod)(size_t, size_t, size_t,
         }
     }
 
-    for (size_t tv_index = 1; tv_index < m_row_indexes.size(); ++tv_index) {
+    for (size_t tv_index = 1, num_rows = size(); tv_index < num_rows; ++tv_index) {
 
-        int64_t signed_row_ndx = m_row_indexes.get(tv_index);
+        int64_t signed_row_ndx = get_row_index(tv_index);
 
         // skip detached references:
         if (signed_row_ndx == detached_ref)
             continue;
 
-        // FIXME: Speed optimization disabled because we need is_null() which is not available on all leaf types.
-/*
-        if (row_ndx < leaf_start || row_ndx >= leaf_end) {
-            size_t ndx_in_leaf;
-            typename ColType::LeafInfo leaf{&arrp, &arr};
-            column->get_leaf(row_ndx, ndx_in_leaf, leaf);
-            leaf_start = row_ndx - ndx_in_leaf;
-            leaf_end = leaf_start + arrp->size();
-        }
-*/
-        auto v = column->get(to_size_t(signed_row_ndx));
+        auto v = reader.get(to_size_t(signed_row_ndx));
 
         if (function == act_Count && v == count_target) {
             res++;
         }
-        else if (function != act_Count && !column->is_null(to_size_t(signed_row_ndx))){
+        else if (function != act_Count && !reader.is_null(to_size_t(signed_row_ndx))){
             non_nulls++;
             R unpacked = static_cast<R>(util::unwrap(v));
 
@@ -258,10 +242,10 @@ Timestamp TableViewBase::minmax_timestamp(size_t column_ndx, size_t* return_ndx)
 {
     C compare = C();
     Timestamp best = Timestamp{};
-    TimestampColumn& column = m_table->get_column_timestamp(column_ndx);
+    ColumnReader<TimestampColumn> column(m_table->get_column_timestamp(column_ndx));
     size_t ndx = npos;
     for (size_t t = 0; t < size(); t++) {
-        int64_t signed_row_ndx = m_row_indexes.get(t);
+        int64_t signed_row_ndx = get_row_index(t);
 
         // skip detached references:
         if (signed_row_ndx == detached_ref)
@@ -395,10 +379,10 @@ size_t TableViewBase::count_double(size_t column_ndx, double target) const
 
 size_t TableViewBase::count_timestamp(size_t column_ndx, Timestamp target) const
 {
-    TimestampColumn& column = m_table->get_column_timestamp(column_ndx);
+    ColumnReader<TimestampColumn> column(m_table->get_column_timestamp(column_ndx));
     size_t count = 0;
     for (size_t t = 0; t < size(); t++) {
-        int64_t signed_row_ndx = m_row_indexes.get(t);
+        int64_t signed_row_ndx = get_row_index(t);
 
         // skip detached references:
         if (signed_row_ndx == detached_ref)
@@ -414,10 +398,92 @@ size_t TableViewBase::count_timestamp(size_t column_ndx, Timestamp target) const
     return count;
 }
 
+template <class T, class Gather>
+void TableViewBase::gather_values(size_t begin, size_t end, T* out, Gather gather) const noexcept
+{
+    check_cookie();
+    REALM_ASSERT_3(begin, <=, end);
+    REALM_ASSERT_3(end, <=, size());
+
+    // Translate the view rows to table rows a chunk at a time
+    const size_t chunk_size = 256;
+    size_t rows[chunk_size];
+    while (begin < end) {
+        size_t n = std::min(end - begin, chunk_size);
+        for (size_t i = 0; i < n; ++i) {
+            int64_t real_ndx = get_row_index(begin + i);
+            REALM_ASSERT(real_ndx != detached_ref);
+            rows[i] = to_size_t(real_ndx);
+        }
+        gather(rows, n, out);
+        begin += n;
+        out += n;
+    }
+}
+
+void TableViewBase::get_ints(size_t col_ndx, size_t begin, size_t end, int64_t* out) const noexcept
+{
+    gather_values(begin, end, out, [&](const size_t* rows, size_t n, int64_t* values) {
+        m_table->gather_ints(col_ndx, rows, n, values);
+    });
+}
+
+void TableViewBase::get_doubles(size_t col_ndx, size_t begin, size_t end, double* out) const noexcept
+{
+    gather_values(begin, end, out, [&](const size_t* rows, size_t n, double* values) {
+        m_table->gather_doubles(col_ndx, rows, n, values);
+    });
+}
+
+void TableViewBase::get_timestamps(size_t col_ndx, size_t begin, size_t end, Timestamp* out) const noexcept
+{
+    gather_values(begin, end, out, [&](const size_t* rows, size_t n, Timestamp* values) {
+        m_table->gather_timestamps(col_ndx, rows, n, values);
+    });
+}
+
+void TableViewBase::get_strings(size_t col_ndx, size_t begin, size_t end, StringData* out) const noexcept
+{
+    gather_values(begin, end, out, [&](const size_t* rows, size_t n, StringData* values) {
+        m_table->gather_strings(col_ndx, rows, n, values);
+    });
+}
+
 // Simple pivot aggregate method. Experimental! Please do not document method publicly.
 void TableViewBase::aggregate(size_t group_by_column, size_t aggr_column, Table::AggrType op, Table& result) const
 {
-    m_table->aggregate(group_by_column, aggr_column, op, result, &m_row_indexes);
+    if (!m_row_bitmap) {
+        m_table->aggregate(group_by_column, aggr_column, op, result, &m_row_indexes);
+        return;
+    }
+
+    // Decode a compact view into a temporary column, leaving the view as it is
+    Allocator& alloc = Allocator::get_default();
+    ref_type ref = IntegerColumn::create(alloc); // Throws
+    _impl::DeepArrayRefDestroyGuard ref_guard(ref, alloc);
+    IntegerColumn rows(alloc, ref); // Throws
+    ref_guard.release();
+    _impl::DestroyGuard<IntegerColumn> rows_guard(&rows);
+    decode_row_bitmap(rows); // Throws
+    m_table->aggregate(group_by_column, aggr_column, op, result, &rows); // Throws
+}
+
+void TableViewBase::aggregate(const std::vector<size_t>& group_by_columns,
+                              const std::vector<Table::AggrSpec>& aggregates, Table& result) const
+{
+    if (!m_row_bitmap) {
+        m_table->aggregate(group_by_columns, aggregates, result, &m_row_indexes);
+        return;
+    }
+
+    Allocator& alloc = Allocator::get_default();
+    ref_type ref = IntegerColumn::create(alloc); // Throws
+    _impl::DeepArrayRefDestroyGuard ref_guard(ref, alloc);
+    IntegerColumn rows(alloc, ref); // Throws
+    ref_guard.release();
+    _impl::DestroyGuard<IntegerColumn> rows_guard(&rows);
+    decode_row_bitmap(rows); // Throws
+    m_table->aggregate(group_by_columns, aggregates, result, &rows); // Throws
 }
 
 void TableViewBase::to_json(std::ostream& out) const
@@ -474,7 +540,7 @@ void TableViewBase::row_to_string(size_t row_ndx, std::ostream& out) const
 {
     check_cookie();
 
-    REALM_ASSERT(row_ndx < m_row_indexes.size());
+    REALM_ASSERT(row_ndx < size());
 
     // Print header (will also calculate widths)
     std::vector<size_t> widths;
@@ -552,15 +618,213 @@ uint_fast64_t TableViewBase::sync_if_needed() const
     return *m_last_seen_version;
 }
 
+bool TableViewBase::can_sync_incrementally() const
+{
+    return m_table && m_changes_version && *m_changes_version == outside_version() && can_track_row_changes();
+}
+
+
+// The rows that a view contains can be brought up to date by re-evaluating
+// the query for individual rows, when the query depends on nothing but the
+// contents of those rows, and the view is either in table order or sorted
+// by columns of the same table.
+bool TableViewBase::can_track_row_changes() const noexcept
+{
+    if (!m_table || !m_table->is_group_level() || m_linkview_source || m_linked_column ||
+        m_distinct_column_source != npos)
+        return false;
+    if (!m_query.m_table || m_query.m_view || m_start != 0 || m_end != size_t(-1) || m_limit != size_t(-1))
+        return false;
+    if (!m_descriptor_ordering.is_empty() &&
+        (m_descriptor_ordering.size() != 1 || !m_descriptor_ordering.descriptor_is_sort(0)))
+        return false;
+
+    // Links, subtables and mixed values make the query and the sort order
+    // depend on other tables
+    const Spec& spec = *m_table->m_spec;
+    for (size_t i = 0, num_cols = spec.get_column_count(); i < num_cols; ++i) {
+        switch (spec.get_column_type(i)) {
+            case col_type_Table:
+            case col_type_Mixed:
+            case col_type_Link:
+            case col_type_LinkList:
+            case col_type_BackLink:
+                return false;
+            default:
+                break;
+        }
+    }
+    return true;
+}
+
+
+// Called whenever the view has just been brought in sync
+void TableViewBase::reset_row_changes() noexcept
+{
+    m_changed_rows.clear();
+    m_changes_version = can_track_row_changes() ? m_last_seen_version : util::none;
+}
+
+
+void TableViewBase::discard_row_changes() noexcept
+{
+    m_changed_rows.clear();
+    m_changes_version = util::none;
+}
+
+
+// Returns true if the row changes of the ongoing transaction advance are still
+// being recorded, and there is room for `num_rows` more.
+bool TableViewBase::prepare_row_changes(size_t num_rows) noexcept
+{
+    if (!m_changes_version)
+        return false;
+    if (!m_table->m_tracking_row_changes || m_changed_rows.size() + num_rows > m_max_changed_rows) {
+        discard_row_changes();
+        return false;
+    }
+    return true;
+}
+
+
+void TableViewBase::record_row_change(size_t row_ndx) noexcept
+{
+    if (!m_changed_rows.empty() && m_changed_rows.back() == row_ndx)
+        return;
+    try {
+        m_changed_rows.push_back(row_ndx); // Throws
+    }
+    catch (...) {
+        discard_row_changes();
+    }
+}
+
+
+void TableViewBase::begin_row_changes(uint_fast64_t version) noexcept
+{
+    // Changes made since the last sync that were not recorded, such as those
+    // of a write transaction, have bumped the table version.
+    if (!m_changes_version || *m_changes_version != version) {
+        discard_row_changes();
+        return;
+    }
+    // Keeps the cost of shifting the recorded rows on insertions and removals
+    // of rows in check
+    const size_t max_changed_rows = 16384;
+    m_max_changed_rows = std::min(m_table->size() / 16 + 16, max_changed_rows);
+}
+
+
+void TableViewBase::end_row_changes(uint_fast64_t version, bool schema_changed) noexcept
+{
+    if (!m_changes_version)
+        return;
+    if (schema_changed) {
+        discard_row_changes();
+        return;
+    }
+    m_changes_version = version;
+}
+
+
+void TableViewBase::adj_row_acc_modify_row(size_t row_ndx) noexcept
+{
+    if (prepare_row_changes(1))
+        record_row_change(row_ndx);
+}
+
+
+// Re-evaluate the query for the rows that were changed since the last sync,
+// and merge the result into the view.
+void TableViewBase::sync_row_changes()
+{
+    // If this function throws, the next sync must rerun the query
+    std::vector<size_t> changed = std::move(m_changed_rows);
+    m_changes_version = util::none;
+
+    std::sort(changed.begin(), changed.end());
+    changed.erase(std::unique(changed.begin(), changed.end()), changed.end());
+    // Rows that were moved past the end of the table by an unordered removal
+    changed.erase(std::lower_bound(changed.begin(), changed.end(), m_table->size()), changed.end());
+
+    std::vector<size_t> matches;
+    if (!changed.empty()) {
+        m_query.init();
+        for (size_t i = 0; i < changed.size();) {
+            // Evaluate each run of consecutive rows in one go
+            size_t begin = changed[i];
+            size_t end = begin + 1;
+            for (++i; i < changed.size() && changed[i] == end; ++i)
+                ++end;
+            while (begin < end) {
+                size_t match = m_query.find_internal(begin, end);
+                if (match == not_found || match >= end)
+                    break;
+                matches.push_back(match); // Throws
+                begin = match + 1;
+            }
+        }
+    }
+
+    apply_row_changes(changed, matches, m_descriptor_ordering); // Throws
+    m_num_detached_refs = 0;
+}
+
+
+// In the compact representation, table modifications that only affect rows
+// after the last row in the view (such as appending rows to the table) leave
+// the view untouched. Anything else would require the plain representation,
+// which cannot be built here without allocating. Instead the view drops its
+// rows and is brought out of sync, such that the next call to
+// sync_if_needed() reruns the query.
+bool TableViewBase::adj_row_acc_prepare(size_t row_ndx) noexcept
+{
+    if (!m_row_bitmap)
+        return true;
+    if (m_row_bitmap->rank(row_ndx) < m_row_bitmap->size())
+        drop_row_bitmap();
+    return false;
+}
+
+
+void TableViewBase::drop_row_bitmap() noexcept
+{
+    m_row_bitmap.reset();
+    m_bitmap_cursor_ndx = npos;
+    m_num_detached_refs = 0;
+    m_last_seen_version = util::none;
+    discard_row_changes();
+}
+
 
 void TableViewBase::adj_row_acc_insert_rows(size_t row_ndx, size_t num_rows) noexcept
 {
+    if (prepare_row_changes(num_rows)) {
+        for (size_t& changed_row_ndx : m_changed_rows) {
+            if (changed_row_ndx >= row_ndx)
+                changed_row_ndx += num_rows;
+        }
+        for (size_t i = 0; i < num_rows; ++i)
+            record_row_change(row_ndx + i);
+    }
+    if (!adj_row_acc_prepare(row_ndx))
+        return;
     m_row_indexes.adjust_ge(int_fast64_t(row_ndx), num_rows);
 }
 
 
 void TableViewBase::adj_row_acc_erase_row(size_t row_ndx) noexcept
 {
+    if (prepare_row_changes(0)) {
+        m_changed_rows.erase(std::remove(m_changed_rows.begin(), m_changed_rows.end(), row_ndx),
+                             m_changed_rows.end());
+        for (size_t& changed_row_ndx : m_changed_rows) {
+            if (changed_row_ndx > row_ndx)
+                --changed_row_ndx;
+        }
+    }
+    if (!adj_row_acc_prepare(row_ndx))
+        return;
     size_t it = 0;
     for (;;) {
         it = m_row_indexes.find_first(row_ndx, it);
@@ -575,6 +839,18 @@ void TableViewBase::adj_row_acc_erase_row(size_t row_ndx) noexcept
 
 void TableViewBase::adj_row_acc_move_over(size_t from_row_ndx, size_t to_row_ndx) noexcept
 {
+    // The row that is moved changes its position in table order, and an
+    // unordered insertion leaves a new row in its place, so both are
+    // re-evaluated.
+    if (prepare_row_changes(2)) {
+        m_changed_rows.erase(std::remove(m_changed_rows.begin(), m_changed_rows.end(), to_row_ndx),
+                             m_changed_rows.end());
+        std::replace(m_changed_rows.begin(), m_changed_rows.end(), from_row_ndx, to_row_ndx);
+        record_row_change(to_row_ndx);
+        record_row_change(from_row_ndx);
+    }
+    if (!adj_row_acc_prepare(std::min(from_row_ndx, to_row_ndx)))
+        return;
     size_t it = 0;
     // kill any refs to the target row ndx
     for (;;) {
@@ -597,6 +873,9 @@ void TableViewBase::adj_row_acc_move_over(size_t from_row_ndx, size_t to_row_ndx
 
 void TableViewBase::adj_row_acc_swap_rows(size_t row_ndx_1, size_t row_ndx_2) noexcept
 {
+    discard_row_changes();
+    if (!adj_row_acc_prepare(std::min(row_ndx_1, row_ndx_2)))
+        return;
     // Always adjust only the earliest ref which matches either ndx_1 or ndx_2
     // to avoid double-swapping the refs
     size_t it_1 = m_row_indexes.find_first(row_ndx_1, 0);
@@ -616,6 +895,9 @@ void TableViewBase::adj_row_acc_swap_rows(size_t row_ndx_1, size_t row_ndx_2) no
 
 void TableViewBase::adj_row_acc_move_row(size_t from_row_ndx, size_t to_row_ndx) noexcept
 {
+    discard_row_changes();
+    if (!adj_row_acc_prepare(std::min(from_row_ndx, to_row_ndx)))
+        return;
     if (from_row_ndx > to_row_ndx)
         ++from_row_ndx;
     else
@@ -631,6 +913,12 @@ void TableViewBase::adj_row_acc_move_row(size_t from_row_ndx, size_t to_row_ndx)
 
 void TableViewBase::adj_row_acc_clear() noexcept
 {
+    if (prepare_row_changes(0))
+        m_changed_rows.clear();
+    if (m_row_bitmap) {
+        drop_row_bitmap();
+        return;
+    }
     m_num_detached_refs = m_row_indexes.size();
     for (size_t i = 0, num_rows = m_row_indexes.size(); i < num_rows; ++i)
         m_row_indexes.set(i, -1);
@@ -642,7 +930,9 @@ void TableView::remove(size_t row_ndx, RemoveMode underlying_mode)
     check_cookie();
 
     REALM_ASSERT(m_table);
-    REALM_ASSERT(row_ndx < m_row_indexes.size());
+    REALM_ASSERT(row_ndx < size());
+
+    materialize_row_indexes(); // Throws
 
     bool sync_to_keep = m_last_seen_version == outside_version();
 
@@ -677,6 +967,7 @@ void TableView::clear(RemoveMode underlying_mode)
     // for the row removals
     using tf = _impl::TableFriend;
     tf::unregister_view(*m_table, this);
+    materialize_row_indexes(); // Throws
 
     bool is_move_last_over = (underlying_mode == RemoveMode::unordered);
     tf::batch_erase_rows(*m_table, m_row_indexes, is_move_last_over); // Throws
@@ -701,12 +992,14 @@ void TableViewBase::distinct(size_t column)
 void TableViewBase::distinct(DistinctDescriptor columns)
 {
     m_descriptor_ordering.append_distinct(std::move(columns));
+    discard_row_changes();
     do_sync();
 }
 
 void TableViewBase::apply_descriptor_ordering(DescriptorOrdering new_ordering)
 {
     m_descriptor_ordering = new_ordering;
+    discard_row_changes();
     do_sync();
 }
 
@@ -733,6 +1026,19 @@ void TableViewBase::do_sync()
     // - Table::get_backlink_view()
     // Here we sync with the respective source.
 
+    if (can_sync_incrementally()) {
+        sync_row_changes(); // Throws
+        m_last_seen_version = outside_version();
+        reset_row_changes();
+        return;
+    }
+
+    // Start over with the plain representation of the row indexes. A query
+    // that produces its results in table order gathers them straight into the
+    // compact representation when they turn out to be dense.
+    m_row_bitmap.reset();
+    m_bitmap_cursor_ndx = npos;
+
     if (m_linkview_source) {
         m_row_indexes.clear();
         for (size_t t = 0; t < m_linkview_source->size(); t++)
@@ -775,6 +1081,7 @@ void TableViewBase::do_sync()
     do_sort(m_descriptor_ordering);
 
     m_last_seen_version = outside_version();
+    reset_row_changes();
 }
 
 bool TableViewBase::is_in_table_order() const
@@ -194,6 +194,13 @@ public:
     DataType get_mixed_type(size_t column_ndx, size_t row_ndx) const noexcept;
     size_t get_link(size_t column_ndx, size_t row_ndx) const noexcept;
 
+    // Getting the values of the rows [begin, end) of the view, see
+    // Table::get_ints()
+    void get_ints(size_t column_ndx, size_t begin, size_t end, int64_t* out) const noexcept;
+    void get_doubles(size_t column_ndx, size_t begin, size_t end, double* out) const noexcept;
+    void get_timestamps(size_t column_ndx, size_t begin, size_t end, Timestamp* out) const noexcept;
+    void get_strings(size_t column_ndx, size_t begin, size_t end, StringData* out) const noexcept;
+
     // Links
     bool is_null_link(size_t column_ndx, size_t row_ndx) const noexcept;
 
@@ -249,6 +256,11 @@ public:
     // document method publicly.
     void aggregate(size_t group_by_column, size_t aggr_column, Table::AggrType op, Table& result) const;
 
+    // Grouped aggregate method, see Table::aggregate(). Experimental! Please
+    // do not document method publicly.
+    void aggregate(const std::vector<size_t>& group_by_columns, const std::vector<Table::AggrSpec>& aggregates,
+                   Table& result) const;
+
     // Get row index in the source table this view is "looking" at.
     size_t get_source_ndx(size_t row_ndx) const noexcept;
 
@@ -285,8 +297,21 @@ public:
     //
     // This will make the TableView empty and in sync with the highest possible table version
     // if the TableView depends on an object (LinkView or row) that has been deleted.
+    //
+    // When the view was last synchronized before advancing the read transaction,
+    // and the advance did nothing but insert, erase and modify rows of the table,
+    // the query is only re-evaluated for the rows that were touched, and the
+    // results are merged into the view, preserving its sort order. Views whose
+    // query is restricted to a range, a limit or another view, views with a
+    // distinct criterion, and views of tables with link, subtable or mixed
+    // columns are always synchronized by rerunning the query.
     uint_fast64_t sync_if_needed() const;
 
+    // Returns true if the next synchronization of this view only needs to
+    // re-evaluate the query for the rows that were changed since the view was
+    // last synchronized.
+    bool can_sync_incrementally() const;
+
     // Sort m_row_indexes according to one column
     void sort(size_t column, bool ascending = true);
 
@@ -355,6 +380,17 @@ protected:
     mutable util::Optional<uint_fast64_t> m_last_seen_version;
 
     size_t m_num_detached_refs = 0;
+
+    // The rows that were inserted, modified or moved by the transaction logs
+    // replayed by Group::advance_transact() since the view was last synced,
+    // and the version of m_table that the view is brought up to by
+    // re-evaluating the query for those rows. m_changes_version is none when
+    // the changes are not known, such that the next sync must rerun the query.
+    std::vector<size_t> m_changed_rows;
+    util::Optional<uint_fast64_t> m_changes_version;
+    // Beyond this number of changed rows, rerunning the query is cheaper
+    size_t m_max_changed_rows = 0;
+
     /// Construct null view (no memory allocated).
     TableViewBase();
 
@@ -410,6 +446,9 @@ protected:
     TableViewBase(TableViewBase& source, HandoverPatch& patch, MutableSourcePayload mode);
 
 private:
+    template <class T, class Gather>
+    void gather_values(size_t begin, size_t end, T* out, Gather gather) const noexcept;
+
     void allocate_row_indexes();
     void detach() const noexcept; // may have to remove const
     size_t find_first_integer(size_t column_ndx, int64_t value) const;
@@ -420,7 +459,19 @@ private:
     friend class Query;
     friend class SharedGroup;
 
+    bool can_track_row_changes() const noexcept;
+    void reset_row_changes() noexcept;
+    void discard_row_changes() noexcept;
+    bool prepare_row_changes(size_t num_rows) noexcept;
+    void record_row_change(size_t row_ndx) noexcept;
+    void sync_row_changes();
+
     // Called by table to adjust any row references:
+    bool adj_row_acc_prepare(size_t row_ndx) noexcept;
+    void drop_row_bitmap() noexcept;
+    void begin_row_changes(uint_fast64_t version) noexcept;
+    void end_row_changes(uint_fast64_t version, bool schema_changed) noexcept;
+    void adj_row_acc_modify_row(size_t row_ndx) noexcept;
     void adj_row_acc_insert_rows(size_t row_ndx, size_t num_rows) noexcept;
     void adj_row_acc_erase_row(size_t row_ndx) noexcept;
     void adj_row_acc_move_over(size_t from_row_ndx, size_t to_row_ndx) noexcept;
@@ -666,7 +717,7 @@ inline const Query& TableViewBase::get_query() const noexcept
 
 inline bool TableViewBase::is_empty() const noexcept
 {
-    return m_row_indexes.is_empty();
+    return m_row_bitmap ? m_row_bitmap->empty() : m_row_indexes.is_empty();
 }
 
 inline bool TableViewBase::is_attached() const noexcept
@@ -676,27 +727,29 @@ inline bool TableViewBase::is_attached() const noexcept
 
 inline bool TableViewBase::is_row_attached(size_t row_ndx) const noexcept
 {
-    return m_row_indexes.get(row_ndx) != detached_ref;
+    return get_row_index(row_ndx) != detached_ref;
 }
 
 inline size_t TableViewBase::size() const noexcept
 {
-    return m_row_indexes.size();
+    return m_row_bitmap ? m_row_bitmap->size() : m_row_indexes.size();
 }
 
 inline size_t TableViewBase::num_attached_rows() const noexcept
 {
-    return m_row_indexes.size() - m_num_detached_refs;
+    return size() - m_num_detached_refs;
 }
 
 inline size_t TableViewBase::get_source_ndx(size_t row_ndx) const noexcept
 {
-    return to_size_t(m_row_indexes.get(row_ndx));
+    return to_size_t(get_row_index(row_ndx));
 }
 
 inline size_t TableViewBase::find_by_source_ndx(size_t source_ndx) const noexcept
 {
     REALM_ASSERT(source_ndx < m_table->size());
+    if (m_row_bitmap)
+        return m_row_bitmap->find(source_ndx);
     return m_row_indexes.find_first(source_ndx);
 }
 
@@ -792,6 +845,8 @@ inline TableViewBase::TableViewBase(const TableViewBase& tv)
     Allocator& alloc = m_row_indexes.get_alloc();
     MemRef mem = tv.m_row_indexes.get_root_array()->clone_deep(alloc); // Throws
     _impl::DeepArrayRefDestroyGuard ref_guard(mem.get_ref(), alloc);
+    if (tv.m_row_bitmap)
+        m_row_bitmap.reset(new RowBitmap(*tv.m_row_bitmap)); // Throws
     if (m_table)
         m_table->register_view(this); // Throws
     m_row_indexes.init_from_mem(alloc, mem);
@@ -815,7 +870,12 @@ inline TableViewBase::TableViewBase(TableViewBase&& tv) noexcept
     // version number so that we can later trigger a sync if needed.
     m_last_seen_version(tv.m_last_seen_version)
     , m_num_detached_refs(tv.m_num_detached_refs)
+    , m_changed_rows(std::move(tv.m_changed_rows))
+    , m_changes_version(tv.m_changes_version)
+    , m_max_changed_rows(tv.m_max_changed_rows)
 {
+    tv.m_changes_version = util::none;
+    m_row_bitmap = std::move(tv.m_row_bitmap);
     if (m_table)
         m_table->move_registered_view(&tv, this);
 }
@@ -838,6 +898,8 @@ inline TableViewBase& TableViewBase::operator=(TableViewBase&& tv) noexcept
         m_table->move_registered_view(&tv, this);
 
     m_row_indexes.move_assign(tv.m_row_indexes);
+    m_row_bitmap = std::move(tv.m_row_bitmap);
+    m_bitmap_cursor_ndx = npos;
     m_query = std::move(tv.m_query);
     m_num_detached_refs = tv.m_num_detached_refs;
     m_last_seen_version = tv.m_last_seen_version;
@@ -849,6 +911,10 @@ inline TableViewBase& TableViewBase::operator=(TableViewBase&& tv) noexcept
     m_linkview_source = std::move(tv.m_linkview_source);
     m_descriptor_ordering = std::move(tv.m_descriptor_ordering);
     m_distinct_column_source = tv.m_distinct_column_source;
+    m_changed_rows = std::move(tv.m_changed_rows);
+    m_changes_version = tv.m_changes_version;
+    m_max_changed_rows = tv.m_max_changed_rows;
+    tv.m_changes_version = util::none;
 
     return *this;
 }
@@ -869,9 +935,14 @@ inline TableViewBase& TableViewBase::operator=(const TableViewBase& tv)
     Allocator& alloc = m_row_indexes.get_alloc();
     MemRef mem = tv.m_row_indexes.get_root_array()->clone_deep(alloc); // Throws
     _impl::DeepArrayRefDestroyGuard ref_guard(mem.get_ref(), alloc);
+    std::unique_ptr<RowBitmap> bitmap;
+    if (tv.m_row_bitmap)
+        bitmap.reset(new RowBitmap(*tv.m_row_bitmap)); // Throws
     m_row_indexes.destroy();
     m_row_indexes.get_root_array()->init_from_mem(mem);
     ref_guard.release();
+    m_row_bitmap = std::move(bitmap);
+    m_bitmap_cursor_ndx = npos;
 
     m_query = tv.m_query;
     m_num_detached_refs = tv.m_num_detached_refs;
@@ -884,6 +955,7 @@ inline TableViewBase& TableViewBase::operator=(const TableViewBase& tv)
     m_linkview_source = tv.m_linkview_source;
     m_descriptor_ordering = tv.m_descriptor_ordering;
     m_distinct_column_source = tv.m_distinct_column_source;
+    discard_row_changes();
 
     return *this;
 }
@@ -894,7 +966,7 @@ inline TableViewBase& TableViewBase::operator=(const TableViewBase& tv)
 
 #define REALM_ASSERT_ROW(row_ndx)                                                                                    \
     REALM_ASSERT(m_table);                                                                                           \
-    REALM_ASSERT(row_ndx < m_row_indexes.size())
+    REALM_ASSERT(row_ndx < size())
 
 #define REALM_ASSERT_COLUMN_AND_TYPE(column_ndx, column_type)                                                        \
     REALM_ASSERT_COLUMN(column_ndx);                                                                                 \
@@ -906,11 +978,11 @@ inline TableViewBase& TableViewBase::operator=(const TableViewBase& tv)
 
 #define REALM_ASSERT_INDEX(column_ndx, row_ndx)                                                                      \
     REALM_ASSERT_COLUMN(column_ndx);                                                                                 \
-    REALM_ASSERT(row_ndx < m_row_indexes.size())
+    REALM_ASSERT(row_ndx < size())
 
 #define REALM_ASSERT_INDEX_AND_TYPE(column_ndx, row_ndx, column_type)                                                \
     REALM_ASSERT_COLUMN_AND_TYPE(column_ndx, column_type);                                                           \
-    REALM_ASSERT(row_ndx < m_row_indexes.size())
+    REALM_ASSERT(row_ndx < size())
 
 #define REALM_ASSERT_INDEX_AND_TYPE_TABLE_OR_MIXED(column_ndx, row_ndx)                                              \
     REALM_ASSERT_COLUMN(column_ndx);                                                                                 \
@@ -919,7 +991,7 @@ inline TableViewBase& TableViewBase::operator=(const TableViewBase& tv)
     REALM_ASSERT(m_table->get_column_type(column_ndx) == type_Table ||                                               \
                  (m_table->get_column_type(column_ndx) == type_Mixed));                                              \
     REALM_DIAG_POP();                                                                                                \
-    REALM_ASSERT(row_ndx < m_row_indexes.size())
+    REALM_ASSERT(row_ndx < size())
 
 // Column information
 
@@ -960,7 +1032,7 @@ inline int64_t TableViewBase::get_int(size_t column_ndx, size_t row_ndx) const n
 {
     REALM_ASSERT_INDEX(column_ndx, row_ndx);
 
-    const int64_t real_ndx = m_row_indexes.get(row_ndx);
+    const int64_t real_ndx = get_row_index(row_ndx);
     REALM_ASSERT(real_ndx != detached_ref);
     return m_table->get_int(column_ndx, to_size_t(real_ndx));
 }
@@ -969,7 +1041,7 @@ inline bool TableViewBase::get_bool(size_t column_ndx, size_t row_ndx) const noe
 {
     REALM_ASSERT_INDEX_AND_TYPE(column_ndx, row_ndx, type_Bool);
 
-    const int64_t real_ndx = m_row_indexes.get(row_ndx);
+    const int64_t real_ndx = get_row_index(row_ndx);
     REALM_ASSERT(real_ndx != detached_ref);
     return m_table->get_bool(column_ndx, to_size_t(real_ndx));
 }
@@ -978,7 +1050,7 @@ inline OldDateTime TableViewBase::get_olddatetime(size_t column_ndx, size_t row_
 {
     REALM_ASSERT_INDEX_AND_TYPE(column_ndx, row_ndx, type_OldDateTime);
 
-    const int64_t real_ndx = m_row_indexes.get(row_ndx);
+    const int64_t real_ndx = get_row_index(row_ndx);
     REALM_ASSERT(real_ndx != detached_ref);
     return m_table->get_olddatetime(column_ndx, to_size_t(real_ndx));
 }
@@ -987,7 +1059,7 @@ inline Timestamp TableViewBase::get_timestamp(size_t column_ndx, size_t row_ndx)
 {
     REALM_ASSERT_INDEX_AND_TYPE(column_ndx, row_ndx, type_Timestamp);
 
-    const int64_t real_ndx = m_row_indexes.get(row_ndx);
+    const int64_t real_ndx = get_row_index(row_ndx);
     REALM_ASSERT(real_ndx != detached_ref);
     return m_table->get_timestamp(column_ndx, to_size_t(real_ndx));
 }
@@ -996,7 +1068,7 @@ inline float TableViewBase::get_float(size_t column_ndx, size_t row_ndx) const n
 {
     REALM_ASSERT_INDEX_AND_TYPE(column_ndx, row_ndx, type_Float);
 
-    const int64_t real_ndx = m_row_indexes.get(row_ndx);
+    const int64_t real_ndx = get_row_index(row_ndx);
     REALM_ASSERT(real_ndx != detached_ref);
     return m_table->get_float(column_ndx, to_size_t(real_ndx));
 }
@@ -1005,7 +1077,7 @@ inline double TableViewBase::get_double(size_t column_ndx, size_t row_ndx) const
 {
     REALM_ASSERT_INDEX_AND_TYPE(column_ndx, row_ndx, type_Double);
 
-    const int64_t real_ndx = m_row_indexes.get(row_ndx);
+    const int64_t real_ndx = get_row_index(row_ndx);
     REALM_ASSERT(real_ndx != detached_ref);
     return m_table->get_double(column_ndx, to_size_t(real_ndx));
 }
@@ -1014,7 +1086,7 @@ inline StringData TableViewBase::get_string(size_t column_ndx, size_t row_ndx) c
 {
     REALM_ASSERT_INDEX_AND_TYPE(column_ndx, row_ndx, type_String);
 
-    const int64_t real_ndx = m_row_indexes.get(row_ndx);
+    const int64_t real_ndx = get_row_index(row_ndx);
     REALM_ASSERT(real_ndx != detached_ref);
     return m_table->get_string(column_ndx, to_size_t(real_ndx));
 }
@@ -1023,7 +1095,7 @@ inline BinaryData TableViewBase::get_binary(size_t column_ndx, size_t row_ndx) c
 {
     REALM_ASSERT_INDEX_AND_TYPE(column_ndx, row_ndx, type_Binary);
 
-    const int64_t real_ndx = m_row_indexes.get(row_ndx);
+    const int64_t real_ndx = get_row_index(row_ndx);
     REALM_ASSERT(real_ndx != detached_ref);
     return m_table->get_binary(column_ndx, to_size_t(real_ndx));
 }
@@ -1032,7 +1104,7 @@ inline Mixed TableViewBase::get_mixed(size_t column_ndx, size_t row_ndx) const n
 {
     REALM_ASSERT_INDEX_AND_TYPE(column_ndx, row_ndx, type_Mixed);
 
-    const int64_t real_ndx = m_row_indexes.get(row_ndx);
+    const int64_t real_ndx = get_row_index(row_ndx);
     REALM_ASSERT(real_ndx != detached_ref);
     return m_table->get_mixed(column_ndx, to_size_t(real_ndx));
 }
@@ -1041,7 +1113,7 @@ inline DataType TableViewBase::get_mixed_type(size_t column_ndx, size_t row_ndx)
 {
     REALM_ASSERT_INDEX_AND_TYPE(column_ndx, row_ndx, type_Mixed);
 
-    const int64_t real_ndx = m_row_indexes.get(row_ndx);
+    const int64_t real_ndx = get_row_index(row_ndx);
     REALM_ASSERT(real_ndx != detached_ref);
     return m_table->get_mixed_type(column_ndx, to_size_t(real_ndx));
 }
@@ -1050,7 +1122,7 @@ inline size_t TableViewBase::get_subtable_size(size_t column_ndx, size_t row_ndx
 {
     REALM_ASSERT_INDEX_AND_TYPE_TABLE_OR_MIXED(column_ndx, row_ndx);
 
-    const int64_t real_ndx = m_row_indexes.get(row_ndx);
+    const int64_t real_ndx = get_row_index(row_ndx);
     REALM_ASSERT(real_ndx != detached_ref);
     return m_table->get_subtable_size(column_ndx, to_size_t(real_ndx));
 }
@@ -1059,7 +1131,7 @@ inline size_t TableViewBase::get_link(size_t column_ndx, size_t row_ndx) const n
 {
     REALM_ASSERT_INDEX_AND_TYPE(column_ndx, row_ndx, type_Link);
 
-    const int64_t real_ndx = m_row_indexes.get(row_ndx);
+    const int64_t real_ndx = get_row_index(row_ndx);
     REALM_ASSERT(real_ndx != detached_ref);
     return m_table->get_link(column_ndx, to_size_t(real_ndx));
 }
@@ -1083,7 +1155,7 @@ inline bool TableViewBase::is_null_link(size_t column_ndx, size_t row_ndx) const
 {
     REALM_ASSERT_INDEX_AND_TYPE(column_ndx, row_ndx, type_Link);
 
-    const int64_t real_ndx = m_row_indexes.get(row_ndx);
+    const int64_t real_ndx = get_row_index(row_ndx);
     REALM_ASSERT(real_ndx != detached_ref);
     return m_table->is_null_link(column_ndx, to_size_t(real_ndx));
 }
@@ -1372,7 +1444,7 @@ inline ConstTableView ConstTableView::find_all_olddatetime(size_t column_ndx, Ol
 inline TableView::RowExpr TableView::get(size_t row_ndx) noexcept
 {
     REALM_ASSERT_ROW(row_ndx);
-    const int64_t real_ndx = m_row_indexes.get(row_ndx);
+    const int64_t real_ndx = get_row_index(row_ndx);
     REALM_ASSERT(real_ndx != detached_ref);
     return m_table->get(to_size_t(real_ndx));
 }
@@ -1380,7 +1452,7 @@ inline TableView::RowExpr TableView::get(size_t row_ndx) noexcept
 inline TableView::ConstRowExpr TableView::get(size_t row_ndx) const noexcept
 {
     REALM_ASSERT_ROW(row_ndx);
-    const int64_t real_ndx = m_row_indexes.get(row_ndx);
+    const int64_t real_ndx = get_row_index(row_ndx);
     REALM_ASSERT(real_ndx != detached_ref);
     return m_table->get(to_size_t(real_ndx));
 }
@@ -1388,7 +1460,7 @@ inline TableView::ConstRowExpr TableView::get(size_t row_ndx) const noexcept
 inline ConstTableView::ConstRowExpr ConstTableView::get(size_t row_ndx) const noexcept
 {
     REALM_ASSERT_ROW(row_ndx);
-    const int64_t real_ndx = m_row_indexes.get(row_ndx);
+    const int64_t real_ndx = get_row_index(row_ndx);
     REALM_ASSERT(real_ndx != detached_ref);
     return m_table->get(to_size_t(real_ndx));
 }
@@ -1449,7 +1521,7 @@ inline TableRef TableView::get_subtable(size_t column_ndx, size_t row_ndx)
 {
     REALM_ASSERT_INDEX_AND_TYPE_TABLE_OR_MIXED(column_ndx, row_ndx);
 
-    const int64_t real_ndx = m_row_indexes.get(row_ndx);
+    const int64_t real_ndx = get_row_index(row_ndx);
     REALM_ASSERT(real_ndx != detached_ref);
     return m_table->get_subtable(column_ndx, to_size_t(real_ndx));
 }
@@ -1458,7 +1530,7 @@ inline ConstTableRef TableView::get_subtable(size_t column_ndx, size_t row_ndx)
 {
     REALM_ASSERT_INDEX_AND_TYPE_TABLE_OR_MIXED(column_ndx, row_ndx);
 
-    const int64_t real_ndx = m_row_indexes.get(row_ndx);
+    const int64_t real_ndx = get_row_index(row_ndx);
     REALM_ASSERT(real_ndx != detached_ref);
     return m_table->get_subtable(column_ndx, to_size_t(real_ndx));
 }
@@ -1467,7 +1539,7 @@ inline ConstTableRef ConstTableView::get_subtable(size_t column_ndx, size_t row_
 {
     REALM_ASSERT_INDEX_AND_TYPE_TABLE_OR_MIXED(column_ndx, row_ndx);
 
-    const int64_t real_ndx = m_row_indexes.get(row_ndx);
+    const int64_t real_ndx = get_row_index(row_ndx);
     REALM_ASSERT(real_ndx != detached_ref);
     return m_table->get_subtable(column_ndx, to_size_t(real_ndx));
 }
@@ -1476,7 +1548,7 @@ inline void TableView::clear_subtable(size_t column_ndx, size_t row_ndx)
 {
     REALM_ASSERT_INDEX_AND_TYPE_TABLE_OR_MIXED(column_ndx, row_ndx);
 
-    const int64_t real_ndx = m_row_indexes.get(row_ndx);
+    const int64_t real_ndx = get_row_index(row_ndx);
     REALM_ASSERT(real_ndx != detached_ref);
     return m_table->clear_subtable(column_ndx, to_size_t(real_ndx));
 }
@@ -1489,7 +1561,7 @@ inline void TableView::set_int(size_t column_ndx, size_t row_ndx, int64_t value)
 {
     REALM_ASSERT_INDEX_AND_TYPE(column_ndx, row_ndx, type_Int);
 
-    const int64_t real_ndx = m_row_indexes.get(row_ndx);
+    const int64_t real_ndx = get_row_index(row_ndx);
     REALM_ASSERT(real_ndx != detached_ref);
     m_table->set_int(column_ndx, to_size_t(real_ndx), value);
 }
@@ -1498,7 +1570,7 @@ inline void TableView::set_bool(size_t column_ndx, size_t row_ndx, bool value)
 {
     REALM_ASSERT_INDEX_AND_TYPE(column_ndx, row_ndx, type_Bool);
 
-    const int64_t real_ndx = m_row_indexes.get(row_ndx);
+    const int64_t real_ndx = get_row_index(row_ndx);
     REALM_ASSERT(real_ndx != detached_ref);
     m_table->set_bool(column_ndx, to_size_t(real_ndx), value);
 }
@@ -1507,7 +1579,7 @@ inline void TableView::set_olddatetime(size_t column_ndx, size_t row_ndx, OldDat
 {
     REALM_ASSERT_INDEX_AND_TYPE(column_ndx, row_ndx, type_OldDateTime);
 
-    const int64_t real_ndx = m_row_indexes.get(row_ndx);
+    const int64_t real_ndx = get_row_index(row_ndx);
     REALM_ASSERT(real_ndx != detached_ref);
     m_table->set_olddatetime(column_ndx, to_size_t(real_ndx), value);
 }
@@ -1516,7 +1588,7 @@ inline void TableView::set_timestamp(size_t column_ndx, size_t row_ndx, Timestam
 {
     REALM_ASSERT_INDEX_AND_TYPE(column_ndx, row_ndx, type_Timestamp);
 
-    const int64_t real_ndx = m_row_indexes.get(row_ndx);
+    const int64_t real_ndx = get_row_index(row_ndx);
     REALM_ASSERT(real_ndx != detached_ref);
     m_table->set_timestamp(column_ndx, to_size_t(real_ndx), value);
 }
@@ -1525,7 +1597,7 @@ inline void TableView::set_float(size_t column_ndx, size_t row_ndx, float value)
 {
     REALM_ASSERT_INDEX_AND_TYPE(column_ndx, row_ndx, type_Float);
 
-    const int64_t real_ndx = m_row_indexes.get(row_ndx);
+    const int64_t real_ndx = get_row_index(row_ndx);
     REALM_ASSERT(real_ndx != detached_ref);
     m_table->set_float(column_ndx, to_size_t(real_ndx), value);
 }
@@ -1534,7 +1606,7 @@ inline void TableView::set_double(size_t column_ndx, size_t row_ndx, double valu
 {
     REALM_ASSERT_INDEX_AND_TYPE(column_ndx, row_ndx, type_Double);
 
-    const int64_t real_ndx = m_row_indexes.get(row_ndx);
+    const int64_t real_ndx = get_row_index(row_ndx);
     REALM_ASSERT(real_ndx != detached_ref);
     m_table->set_double(column_ndx, to_size_t(real_ndx), value);
 }
@@ -1542,7 +1614,7 @@ inline void TableView::set_double(size_t column_ndx, size_t row_ndx, double valu
 template <class E>
 inline void TableView::set_enum(size_t column_ndx, size_t row_ndx, E value)
 {
-    const int64_t real_ndx = m_row_indexes.get(row_ndx);
+    const int64_t real_ndx = get_row_index(row_ndx);
     REALM_ASSERT(real_ndx != detached_ref);
     m_table->set_int(column_ndx, real_ndx, value);
 }
@@ -1551,7 +1623,7 @@ inline void TableView::set_string(size_t column_ndx, size_t row_ndx, StringData
 {
     REALM_ASSERT_INDEX_AND_TYPE(column_ndx, row_ndx, type_String);
 
-    const int64_t real_ndx = m_row_indexes.get(row_ndx);
+    const int64_t real_ndx = get_row_index(row_ndx);
     REALM_ASSERT(real_ndx != detached_ref);
     m_table->set_string(column_ndx, to_size_t(real_ndx), value);
 }
@@ -1560,7 +1632,7 @@ inline void TableView::set_binary(size_t column_ndx, size_t row_ndx, BinaryData
 {
     REALM_ASSERT_INDEX_AND_TYPE(column_ndx, row_ndx, type_Binary);
 
-    const int64_t real_ndx = m_row_indexes.get(row_ndx);
+    const int64_t real_ndx = get_row_index(row_ndx);
     REALM_ASSERT(real_ndx != detached_ref);
     m_table->set_binary(column_ndx, to_size_t(real_ndx), value);
 }
@@ -1569,7 +1641,7 @@ inline void TableView::set_mixed(size_t column_ndx, size_t row_ndx, Mixed value)
 {
     REALM_ASSERT_INDEX_AND_TYPE(column_ndx, row_ndx, type_Mixed);
 
-    const int64_t real_ndx = m_row_indexes.get(row_ndx);
+    const int64_t real_ndx = get_row_index(row_ndx);
     REALM_ASSERT(real_ndx != detached_ref);
     m_table->set_mixed(column_ndx, to_size_t(real_ndx), value);
 }
@@ -1577,7 +1649,7 @@ inline void TableView::set_mixed(size_t column_ndx, size_t row_ndx, Mixed value)
 inline void TableView::set_subtable(size_t column_ndx, size_t row_ndx, const Table* value)
 {
     REALM_ASSERT_INDEX_AND_TYPE_TABLE_OR_MIXED(column_ndx, row_ndx);
-    const int64_t real_ndx = m_row_indexes.get(row_ndx);
+    const int64_t real_ndx = get_row_index(row_ndx);
     REALM_ASSERT(real_ndx != detached_ref);
     m_table->set_subtable(column_ndx, to_size_t(real_ndx), value);
 }
@@ -1585,7 +1657,7 @@ inline void TableView::set_subtable(size_t column_ndx, size_t row_ndx, const Tab
 inline void TableView::set_link(size_t column_ndx, size_t row_ndx, size_t target_row_ndx)
 {
     REALM_ASSERT_INDEX_AND_TYPE(column_ndx, row_ndx, type_Link);
-    const int64_t real_ndx = m_row_indexes.get(row_ndx);
+    const int64_t real_ndx = get_row_index(row_ndx);
     REALM_ASSERT(real_ndx != detached_ref);
     m_table->set_link(column_ndx, to_size_t(real_ndx), target_row_ndx);
 }
@@ -1593,7 +1665,7 @@ inline void TableView::set_link(size_t column_ndx, size_t row_ndx, size_t target
 inline void TableView::nullify_link(size_t column_ndx, size_t row_ndx)
 {
     REALM_ASSERT_INDEX_AND_TYPE(column_ndx, row_ndx, type_Link);
-    const int64_t real_ndx = m_row_indexes.get(row_ndx);
+    const int64_t real_ndx = get_row_index(row_ndx);
     REALM_ASSERT(real_ndx != detached_ref);
     m_table->nullify_link(column_ndx, to_size_t(real_ndx));
 }
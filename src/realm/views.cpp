@@ -18,8 +18,20 @@
 
 #include <realm/views.hpp>
 
+#include <realm/column_binary.hpp>
 #include <realm/column_link.hpp>
+#include <realm/column_string.hpp>
+#include <realm/column_string_enum.hpp>
+#include <realm/column_timestamp.hpp>
+#include <realm/impl/column_reader.hpp>
+#include <realm/impl/destroy_guard.hpp>
 #include <realm/table.hpp>
+#include <realm/util/thread.hpp>
+
+#include <atomic>
+#include <cstring>
+#include <typeinfo>
+#include <unordered_set>
 
 using namespace realm;
 
@@ -104,6 +116,20 @@ public:
 
     bool operator()(IndexPair i, IndexPair j, bool total_ordering = true) const;
 
+    /// Sort `v` with a radix sort on keys gathered from the sort column, if
+    /// this sorts on a single integer, float, double or timestamp column and
+    /// `v` is large enough for that to pay off. Returns false, leaving `v`
+    /// untouched, if `v` must be sorted by comparison instead.
+    bool radix_sort(std::vector<IndexPair>& v) const;
+
+    /// Returns whether rows `i` and `j` have the same values in all columns.
+    /// Neither may have a null link on the way to a column.
+    bool equal(IndexPair i, IndexPair j) const noexcept;
+
+    /// Returns a hash of the values of row `i` that is the same for rows that
+    /// are `equal()`. Row `i` may not have a null link on the way to a column.
+    size_t hash(IndexPair i) const noexcept;
+
     bool has_links() const
     {
         return std::any_of(m_columns.begin(), m_columns.end(),
@@ -224,6 +250,384 @@ bool SortDescriptor::Sorter::operator()(IndexPair i, IndexPair j, bool total_ord
     return total_ordering ? i.index_in_view < j.index_in_view : 0;
 }
 
+namespace {
+
+// Sort key of a single row for the radix sort. `key` is the primary key and
+// `minor` breaks ties, both encoded such that unsigned order is value order.
+struct RadixEntry {
+    uint64_t key;
+    uint64_t minor;
+    IndexPair pair;
+};
+
+// Sorts below this size are left to std::sort, for which gathering the keys
+// does not pay off.
+const size_t radix_sort_threshold = 256;
+
+// Each thread of a parallel sort gets at least this many rows, as starting a
+// thread costs about as much as sorting that many keys.
+const size_t parallel_sort_min_rows_per_thread = 65536;
+
+std::atomic<size_t> g_sort_thread_budget(1);
+
+inline uint64_t int_key(int64_t value) noexcept
+{
+    return uint64_t(value) ^ (uint64_t(1) << 63);
+}
+
+template <class T>
+uint64_t float_key(T value) noexcept
+{
+    using Bits = typename std::conditional<sizeof(T) == 4, uint32_t, uint64_t>::type;
+    // -0.0 and 0.0 compare equal, so they must get the same key
+    if (value == 0)
+        value = 0;
+    Bits bits;
+    std::memcpy(&bits, &value, sizeof bits);
+    const Bits sign = Bits(1) << (sizeof(Bits) * 8 - 1);
+    // Negative values are ordered by decreasing magnitude
+    return (bits & sign) ? Bits(~bits) : Bits(bits | sign);
+}
+
+// Stable least significant digit radix sort of [begin, end) on the given
+// field, one byte at a time, using `buffer` of the same size as scratch space.
+// Bytes that are the same for all entries are skipped.
+void radix_sort_by(RadixEntry* begin, RadixEntry* end, RadixEntry* buffer, uint64_t RadixEntry::*field) noexcept
+{
+    size_t n = end - begin;
+    if (n < 2)
+        return;
+    size_t counts[8][256] = {};
+    for (const RadixEntry* e = begin; e != end; ++e) {
+        uint64_t k = e->*field;
+        for (int digit = 0; digit < 8; ++digit)
+            ++counts[digit][(k >> (digit * 8)) & 0xFF];
+    }
+    RadixEntry* from = begin;
+    RadixEntry* to = buffer;
+    for (int digit = 0; digit < 8; ++digit) {
+        size_t* count = counts[digit];
+        int shift = digit * 8;
+        if (count[(from->*field >> shift) & 0xFF] == n)
+            continue;
+        size_t offset = 0;
+        for (size_t i = 0; i < 256; ++i) {
+            size_t c = count[i];
+            count[i] = offset;
+            offset += c;
+        }
+        for (const RadixEntry* e = from; e != from + n; ++e)
+            to[count[(e->*field >> shift) & 0xFF]++] = *e;
+        std::swap(from, to);
+    }
+    if (from != begin)
+        std::copy(from, from + n, begin);
+}
+
+// Calls func(i) for each i in [0, n), on the calling thread and n - 1 worker
+// threads. `func` must not throw.
+template <class F>
+void run_in_parallel(size_t n, F func)
+{
+    std::unique_ptr<util::Thread[]> threads(new util::Thread[n - 1]); // Throws
+    size_t num_started = 0;
+    auto join_started = [&] {
+        for (size_t i = 0; i < num_started; ++i)
+            threads[i].join();
+    };
+    try {
+        for (; num_started < n - 1; ++num_started) {
+            size_t i = num_started + 1;
+            threads[num_started].start([&func, i] { func(i); }); // Throws
+        }
+    }
+    catch (...) {
+        join_started();
+        throw;
+    }
+    func(0);
+    join_started();
+}
+
+// Sorts [begin, end) in `num_runs` runs on as many threads, and then merges
+// neighbouring runs in parallel until one is left. The merge is stable, so
+// ties keep the order of the input.
+void parallel_radix_sort(RadixEntry* begin, RadixEntry* end, RadixEntry* buffer, size_t num_runs, bool has_minor)
+{
+    size_t n = end - begin;
+    std::vector<size_t> bounds(num_runs + 1); // Throws
+    for (size_t i = 0; i <= num_runs; ++i)
+        bounds[i] = n * i / num_runs;
+
+    run_in_parallel(num_runs, [&](size_t i) { // Throws
+        RadixEntry* run_begin = begin + bounds[i];
+        RadixEntry* run_end = begin + bounds[i + 1];
+        RadixEntry* run_buffer = buffer + bounds[i];
+        if (has_minor)
+            radix_sort_by(run_begin, run_end, run_buffer, &RadixEntry::minor);
+        radix_sort_by(run_begin, run_end, run_buffer, &RadixEntry::key);
+    });
+
+    auto less = [](const RadixEntry& a, const RadixEntry& b) {
+        return a.key < b.key || (a.key == b.key && a.minor < b.minor);
+    };
+    RadixEntry* from = begin;
+    RadixEntry* to = buffer;
+    while (bounds.size() > 2) {
+        size_t num_merges = bounds.size() / 2;
+        run_in_parallel(num_merges, [&](size_t i) { // Throws
+            size_t first = bounds[2 * i];
+            size_t middle = bounds[2 * i + 1];
+            size_t last = 2 * i + 2 < bounds.size() ? bounds[2 * i + 2] : middle;
+            std::merge(from + first, from + middle, from + middle, from + last, to + first, less);
+        });
+        std::vector<size_t> merged_bounds;
+        for (size_t i = 0; i < bounds.size(); i += 2)
+            merged_bounds.push_back(bounds[i]); // Throws
+        if (merged_bounds.back() != n)
+            merged_bounds.push_back(n); // Throws
+        bounds.swap(merged_bounds);
+        std::swap(from, to);
+    }
+    if (from != begin)
+        std::copy(from, from + n, begin);
+}
+
+} // anonymous namespace
+
+void realm::set_sort_thread_budget(size_t num_threads) noexcept
+{
+    g_sort_thread_budget = std::max(num_threads, size_t(1));
+}
+
+size_t realm::get_sort_thread_budget() noexcept
+{
+    return g_sort_thread_budget;
+}
+
+namespace {
+
+inline size_t hash_combine(size_t seed, size_t value) noexcept
+{
+    return seed ^ (value + 0x9e3779b9 + (seed << 6) + (seed >> 2));
+}
+
+// FNV-1a
+size_t hash_bytes(const char* data, size_t size) noexcept
+{
+    uint64_t h = 14695981039346656037ULL;
+    for (size_t i = 0; i < size; ++i) {
+        h ^= static_cast<unsigned char>(data[i]);
+        h *= 1099511628211ULL;
+    }
+    return size_t(h);
+}
+
+const size_t null_hash = size_t(-1);
+
+// Hash of the value of a row in a column, consistent with compare_values().
+// Columns of other types get the same hash for all rows, which is correct
+// but makes the hash set degenerate to a linear search.
+size_t hash_value(const ColumnBase& column, size_t row) noexcept
+{
+    const std::type_info& type = typeid(column);
+    if (type == typeid(StringEnumColumn)) {
+        // Equal strings have the same key, so the key index can be hashed
+        // without looking up the string
+        return std::hash<int64_t>()(static_cast<const IntegerColumn&>(column).get(row));
+    }
+    if (auto c = dynamic_cast<const IntegerColumn*>(&column)) {
+        // Includes link columns, for which the stored value identifies the
+        // target row
+        return std::hash<int64_t>()(c->get(row));
+    }
+    if (auto c = dynamic_cast<const IntNullColumn*>(&column)) {
+        util::Optional<int64_t> value = c->get(row);
+        return value ? std::hash<int64_t>()(*value) : null_hash;
+    }
+    if (auto c = dynamic_cast<const FloatColumn*>(&column)) {
+        if (c->is_null(row))
+            return null_hash;
+        float value = c->get(row);
+        // -0.0 and 0.0 compare equal
+        return value == 0 ? 0 : std::hash<float>()(value);
+    }
+    if (auto c = dynamic_cast<const DoubleColumn*>(&column)) {
+        if (c->is_null(row))
+            return null_hash;
+        double value = c->get(row);
+        return value == 0 ? 0 : std::hash<double>()(value);
+    }
+    if (auto c = dynamic_cast<const TimestampColumn*>(&column)) {
+        Timestamp value = c->get(row);
+        if (value.is_null())
+            return null_hash;
+        return hash_combine(std::hash<int64_t>()(value.get_seconds()), std::hash<int32_t>()(value.get_nanoseconds()));
+    }
+    if (auto c = dynamic_cast<const StringColumn*>(&column)) {
+        StringData value = c->get(row);
+        return value.is_null() ? null_hash : hash_bytes(value.data(), value.size());
+    }
+    if (auto c = dynamic_cast<const BinaryColumn*>(&column)) {
+        BinaryData value = c->get(row);
+        return value.is_null() ? null_hash : hash_bytes(value.data(), value.size());
+    }
+    return 0;
+}
+
+} // anonymous namespace
+
+bool CommonDescriptor::Sorter::equal(IndexPair i, IndexPair j) const noexcept
+{
+    for (const SortColumn& col : m_columns) {
+        size_t index_i = i.index_in_column;
+        size_t index_j = j.index_in_column;
+        if (!col.translated_row.empty()) {
+            REALM_ASSERT_DEBUG(!col.is_null[i.index_in_view] && !col.is_null[j.index_in_view]);
+            index_i = col.translated_row[i.index_in_view];
+            index_j = col.translated_row[j.index_in_view];
+        }
+        if (col.column->compare_values(index_i, index_j) != 0)
+            return false;
+    }
+    return true;
+}
+
+size_t CommonDescriptor::Sorter::hash(IndexPair i) const noexcept
+{
+    size_t h = 0;
+    for (const SortColumn& col : m_columns) {
+        size_t index = i.index_in_column;
+        if (!col.translated_row.empty()) {
+            REALM_ASSERT_DEBUG(!col.is_null[i.index_in_view]);
+            index = col.translated_row[i.index_in_view];
+        }
+        h = hash_combine(h, hash_value(*col.column, index));
+    }
+    return h;
+}
+
+bool SortDescriptor::Sorter::radix_sort(std::vector<IndexPair>& v) const
+{
+    if (m_columns.size() != 1 || v.size() < radix_sort_threshold)
+        return false;
+
+    const SortColumn& sort_col = m_columns[0];
+    const ColumnBase* col = sort_col.column;
+    const std::type_info& type = typeid(*col);
+    bool is_int = type == typeid(IntegerColumn);
+    bool is_int_null = type == typeid(IntNullColumn);
+    bool is_float = type == typeid(FloatColumn);
+    bool is_double = type == typeid(DoubleColumn);
+    bool is_timestamp = type == typeid(TimestampColumn);
+    if (!is_int && !is_int_null && !is_float && !is_double && !is_timestamp)
+        return false;
+
+    // Ties are broken by the position in the view, which the radix sort
+    // preserves only if the rows are already in that order.
+    for (size_t i = 1; i < v.size(); ++i) {
+        if (v[i - 1].index_in_view >= v[i].index_in_view)
+            return false;
+    }
+
+    bool has_links = !sort_col.translated_row.empty();
+    std::vector<RadixEntry> entries;
+    std::vector<IndexPair> null_values;
+    std::vector<IndexPair> null_links;
+    entries.reserve(v.size()); // Throws
+
+    // Gather the keys, looking up values through the cached leaf when
+    // consecutive rows live in the same leaf.
+    auto gather = [&](auto&& reader, auto make_entry) {
+        for (IndexPair p : v) {
+            size_t row = p.index_in_column;
+            if (has_links) {
+                if (sort_col.is_null[p.index_in_view]) {
+                    null_links.push_back(p); // Throws
+                    continue;
+                }
+                row = sort_col.translated_row[p.index_in_view];
+            }
+            if (!make_entry(reader.get(row), p))
+                null_values.push_back(p); // Throws
+        }
+    };
+
+    if (is_int) {
+        gather(ColumnReader<IntegerColumn>(static_cast<const IntegerColumn&>(*col)), [&](int64_t value, IndexPair p) {
+            entries.push_back({int_key(value), 0, p}); // Throws
+            return true;
+        });
+    }
+    else if (is_int_null) {
+        gather(ColumnReader<IntNullColumn>(static_cast<const IntNullColumn&>(*col)),
+               [&](util::Optional<int64_t> value, IndexPair p) {
+                   if (!value)
+                       return false;
+                   entries.push_back({int_key(*value), 0, p}); // Throws
+                   return true;
+               });
+    }
+    else if (is_float) {
+        bool nullable = col->is_nullable();
+        gather(ColumnReader<FloatColumn>(static_cast<const FloatColumn&>(*col)), [&](float value, IndexPair p) {
+            if (nullable && null::is_null_float(value))
+                return false;
+            entries.push_back({float_key(value), 0, p}); // Throws
+            return true;
+        });
+    }
+    else if (is_double) {
+        bool nullable = col->is_nullable();
+        gather(ColumnReader<DoubleColumn>(static_cast<const DoubleColumn&>(*col)), [&](double value, IndexPair p) {
+            if (nullable && null::is_null_float(value))
+                return false;
+            entries.push_back({float_key(value), 0, p}); // Throws
+            return true;
+        });
+    }
+    else {
+        gather(ColumnReader<TimestampColumn>(static_cast<const TimestampColumn&>(*col)),
+               [&](Timestamp value, IndexPair p) {
+                   if (value.is_null())
+                       return false;
+                   entries.push_back({int_key(value.get_seconds()), int_key(value.get_nanoseconds()), p}); // Throws
+                   return true;
+               });
+    }
+
+    if (!entries.empty()) {
+        if (!sort_col.ascending) {
+            for (RadixEntry& e : entries) {
+                e.key = ~e.key;
+                e.minor = ~e.minor;
+            }
+        }
+        std::vector<RadixEntry> buffer(entries.size()); // Throws
+        RadixEntry* begin = entries.data();
+        RadixEntry* end = begin + entries.size();
+        size_t num_threads = std::min(get_sort_thread_budget(), entries.size() / parallel_sort_min_rows_per_thread);
+        if (num_threads > 1) {
+            parallel_radix_sort(begin, end, buffer.data(), num_threads, is_timestamp); // Throws
+        }
+        else {
+            if (is_timestamp)
+                radix_sort_by(begin, end, buffer.data(), &RadixEntry::minor);
+            radix_sort_by(begin, end, buffer.data(), &RadixEntry::key);
+        }
+    }
+
+    // Null values sort before all other values, and null links after them,
+    // when ascending.
+    std::vector<IndexPair>& first = sort_col.ascending ? null_values : null_links;
+    std::vector<IndexPair>& last = sort_col.ascending ? null_links : null_values;
+    auto out = std::copy(first.begin(), first.end(), v.begin());
+    for (const RadixEntry& e : entries)
+        *out++ = e.pair;
+    std::copy(last.begin(), last.end(), out);
+    return true;
+}
+
 DescriptorOrdering::DescriptorOrdering(const DescriptorOrdering& other)
 {
     for (const auto& d : other.m_descriptors) {
@@ -341,6 +745,7 @@ void RowIndexes::do_sort(const DescriptorOrdering& ordering) {
     size_t sz = size();
     if (sz == 0)
         return;
+    materialize_row_indexes(); // Throws
 
     // Gather the current rows into a container we can use std algorithms on
     size_t detached_ref_count = 0;
@@ -367,7 +772,8 @@ void RowIndexes::do_sort(const DescriptorOrdering& ordering) {
 
             SortDescriptor::Sorter sort_predicate = sort_descr->sorter(m_row_indexes);
 
-            std::sort(v.begin(), v.end(), std::ref(sort_predicate));
+            if (!sort_predicate.radix_sort(v)) // Throws
+                std::sort(v.begin(), v.end(), std::ref(sort_predicate));
 
             bool is_last_ordering = desc_ndx == num_descriptors - 1;
             // not doing this on the last step is an optimisation
@@ -391,22 +797,18 @@ void RowIndexes::do_sort(const DescriptorOrdering& ordering) {
                         v.end());
             }
 
-            // Sort by the columns to distinct on
-            std::sort(v.begin(), v.end(), std::ref(distinct_predicate));
-
-            // Remove all duplicates
-            v.erase(std::unique(v.begin(), v.end(),
-                                [&](auto&& a, auto&& b) {
-                                    // "not less than" is "equal" since they're sorted
-                                    return !distinct_predicate(a, b, false);
-                                }),
-                    v.end());
-            bool will_be_sorted_next = desc_ndx < num_descriptors - 1 && ordering.descriptor_is_sort(desc_ndx + 1);
-            if (!will_be_sorted_next) {
-                // Restore the original order, this is either the original
-                // tableview order or the order of the previous sort
-                std::sort(v.begin(), v.end(), [](auto a, auto b) { return a.index_in_view < b.index_in_view; });
+            // Keep the first row of each set of equal rows. The rows are in
+            // the original tableview order or the order of the previous sort,
+            // so that order is preserved.
+            auto hash = [&](IndexPair i) { return distinct_predicate.hash(i); };
+            auto equal = [&](IndexPair i, IndexPair j) { return distinct_predicate.equal(i, j); };
+            std::unordered_set<IndexPair, decltype(hash), decltype(equal)> seen(v.size(), hash, equal); // Throws
+            size_t num_distinct = 0;
+            for (IndexPair i : v) {
+                if (seen.insert(i).second) // Throws
+                    v[num_distinct++] = i;
             }
+            v.resize(num_distinct);
         }
     }
     // Apply the results
@@ -417,6 +819,164 @@ void RowIndexes::do_sort(const DescriptorOrdering& ordering) {
         m_row_indexes.add(-1);
 }
 
+void RowIndexes::compact_row_indexes()
+{
+    if (!m_row_indexes.is_attached())
+        return;
+
+    size_t sz = m_row_indexes.size();
+    if (m_row_bitmap) {
+        // Move a further batch of rows into the bitmap
+        for (size_t i = 0; i < sz; ++i) {
+            int64_t row_ndx = m_row_indexes.get(i);
+            REALM_ASSERT_DEBUG(row_ndx >= 0);
+            m_row_bitmap->add(size_t(row_ndx)); // Throws
+        }
+        m_row_indexes.clear(); // Throws
+        m_bitmap_cursor_ndx = npos;
+        return;
+    }
+
+    // Small results are not worth the trouble
+    if (sz < compact_min_size)
+        return;
+
+    // Only use the compact form when the rows are dense enough that the bitmap
+    // will mainly consist of bitsets.
+    int64_t first = m_row_indexes.get(0);
+    int64_t last = m_row_indexes.back();
+    if (first < 0 || last < first || size_t(last - first) / compact_max_sparseness >= sz)
+        return;
+
+    std::unique_ptr<RowBitmap> bitmap(new RowBitmap); // Throws
+    int64_t prev = -1;
+    for (size_t i = 0; i < sz; ++i) {
+        int64_t row_ndx = m_row_indexes.get(i);
+        // Detached entries, duplicates and unordered rows cannot be represented
+        if (row_ndx <= prev)
+            return;
+        bitmap->add(size_t(row_ndx)); // Throws
+        prev = row_ndx;
+    }
+
+    m_row_indexes.clear(); // Throws
+    m_row_bitmap = std::move(bitmap);
+    m_bitmap_cursor_ndx = npos;
+}
+
+void RowIndexes::materialize_row_indexes()
+{
+    if (!m_row_bitmap)
+        return;
+
+    REALM_ASSERT(m_row_indexes.is_empty());
+    Allocator& alloc = Allocator::get_default();
+    ref_type ref = IntegerColumn::create(alloc); // Throws
+    _impl::DeepArrayRefDestroyGuard ref_guard(ref, alloc);
+    IntegerColumn rows(alloc, ref); // Throws
+    ref_guard.release();
+    _impl::DestroyGuard<IntegerColumn> rows_guard(&rows);
+    decode_row_bitmap(rows); // Throws
+
+    // Nothing below can throw, so the view is never left half converted
+    m_row_indexes.move_assign(rows);
+    rows_guard.release();
+    m_row_bitmap.reset();
+    m_bitmap_cursor_ndx = npos;
+}
+
+void RowIndexes::decode_row_bitmap(IntegerColumn& rows) const
+{
+    REALM_ASSERT(m_row_bitmap && rows.is_empty());
+    for (size_t row_ndx : *m_row_bitmap)
+        rows.add(int64_t(row_ndx)); // Throws
+}
+
+void RowIndexes::assign_row_bitmap(const RowBitmap& rows)
+{
+    REALM_ASSERT(!m_row_bitmap && m_row_indexes.is_empty());
+    size_t sz = rows.size();
+    if (sz >= compact_min_size) {
+        size_t first = *rows.begin();
+        size_t last = *--rows.end();
+        if ((last - first) / compact_max_sparseness < sz) {
+            m_row_bitmap.reset(new RowBitmap(rows)); // Throws
+            m_bitmap_cursor_ndx = npos;
+            return;
+        }
+    }
+    for (size_t row_ndx : rows)
+        m_row_indexes.add(int64_t(row_ndx)); // Throws
+}
+
+void RowIndexes::apply_row_changes(const std::vector<size_t>& changed, const std::vector<size_t>& matches,
+                                   const DescriptorOrdering& ordering)
+{
+    if (m_row_bitmap) {
+        // In the compact representation the rows can be updated in place
+        REALM_ASSERT(ordering.is_empty());
+        m_bitmap_cursor_ndx = npos;
+        auto match = matches.begin();
+        for (size_t row_ndx : changed) {
+            if (match != matches.end() && *match == row_ndx) {
+                m_row_bitmap->add(row_ndx); // Throws
+                ++match;
+            }
+            else {
+                m_row_bitmap->remove(row_ndx);
+            }
+        }
+        return;
+    }
+
+    // Unordered removals may have moved rows out of table order, and the sort
+    // key of a changed row may have changed, so the changed rows are taken
+    // out, and put back in where they belong in a single merging pass.
+    const SortDescriptor* sort_descr = nullptr;
+    if (!ordering.is_empty()) {
+        REALM_ASSERT(ordering.size() == 1 && ordering.descriptor_is_sort(0));
+        sort_descr = static_cast<const SortDescriptor*>(ordering[0]);
+    }
+    SortDescriptor::Sorter sort_predicate;
+    if (sort_descr)
+        sort_predicate = sort_descr->sorter(m_row_indexes); // Throws
+    // A freshly run query lists the rows in table order before it is sorted,
+    // so ties are broken by row index.
+    auto less = [&](IndexPair a, IndexPair b) {
+        return sort_descr ? sort_predicate(a, b) : a.index_in_column < b.index_in_column;
+    };
+
+    std::vector<IndexPair> added;
+    added.reserve(matches.size()); // Throws
+    for (size_t row_ndx : matches)
+        added.push_back(IndexPair{row_ndx, row_ndx});
+    if (sort_descr)
+        std::sort(added.begin(), added.end(), std::ref(less));
+
+    Allocator& alloc = Allocator::get_default();
+    ref_type ref = IntegerColumn::create(alloc); // Throws
+    _impl::DeepArrayRefDestroyGuard ref_guard(ref, alloc);
+    IntegerColumn rows(alloc, ref); // Throws
+    ref_guard.release();
+    _impl::DestroyGuard<IntegerColumn> rows_guard(&rows);
+
+    auto next = added.begin();
+    for (size_t i = 0, num_rows = m_row_indexes.size(); i < num_rows; ++i) {
+        int64_t ndx = m_row_indexes.get(i);
+        if (ndx == detached_ref || std::binary_search(changed.begin(), changed.end(), size_t(ndx)))
+            continue;
+        IndexPair pair{size_t(ndx), size_t(ndx)};
+        for (; next != added.end() && less(*next, pair); ++next)
+            rows.add(int64_t(next->index_in_column)); // Throws
+        rows.add(ndx); // Throws
+    }
+    for (; next != added.end(); ++next)
+        rows.add(int64_t(next->index_in_column)); // Throws
+
+    m_row_indexes.move_assign(rows);
+    rows_guard.release();
+}
+
 RowIndexes::RowIndexes(IntegerColumn::unattached_root_tag urt, realm::Allocator& alloc)
     : m_row_indexes(urt, alloc)
 #ifdef REALM_COOKIE_CHECK
@@ -446,6 +1006,8 @@ RowIndexes::RowIndexes(const RowIndexes& source, ConstSourcePayload mode)
     if (mode == ConstSourcePayload::Copy && source.m_row_indexes.is_attached()) {
         MemRef mem = source.m_row_indexes.clone_deep(Allocator::get_default());
         m_row_indexes.init_from_mem(Allocator::get_default(), mem);
+        if (source.m_row_bitmap)
+            m_row_bitmap.reset(new RowBitmap(*source.m_row_bitmap)); // Throws
     }
 }
 
@@ -464,5 +1026,7 @@ RowIndexes::RowIndexes(RowIndexes& source, MutableSourcePayload)
         m_row_indexes.detach();
         m_row_indexes.init_from_mem(Allocator::get_default(), source.m_row_indexes.get_mem());
         source.m_row_indexes.init_from_ref(Allocator::get_default(), IntegerColumn::create(Allocator::get_default()));
+        m_row_bitmap = std::move(source.m_row_bitmap);
+        source.m_bitmap_cursor_ndx = npos;
     }
 }
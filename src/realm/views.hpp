@@ -21,7 +21,9 @@
 
 #include <realm/column.hpp>
 #include <realm/handover_defs.hpp>
+#include <realm/row_bitmap.hpp>
 
+#include <memory>
 #include <vector>
 
 namespace realm {
@@ -97,6 +99,14 @@ private:
     std::vector<bool> m_ascending;
 };
 
+/// Set the maximum number of threads, including the calling thread, that
+/// may be used to sort a single table view or link view. Sorts on a single
+/// integer, boolean, float, double or timestamp column that are large enough
+/// are split into runs sorted on separate threads and then merged. The
+/// default is 1. Other sorts and distinct always run on the calling thread.
+void set_sort_thread_budget(size_t num_threads) noexcept;
+size_t get_sort_thread_budget() noexcept;
+
 // Distinct uses the same syntax as sort except that the order is meaningless.
 typedef CommonDescriptor DistinctDescriptor;
 
@@ -167,15 +177,95 @@ public:
 #endif
     }
 
+    /// Returns the row index stored at the specified position, which is
+    /// `detached_ref` for a detached entry. This works for both the plain and
+    /// the compact representation of the row indexes.
+    int64_t get_row_index(size_t ndx) const noexcept;
+
+    /// Returns true if the row indexes are currently held in the compact
+    /// representation (see compact_row_indexes()).
+    bool is_compact() const noexcept
+    {
+        return bool(m_row_bitmap);
+    }
+
     IntegerColumn m_row_indexes;
 
 protected:
     void do_sort(const DescriptorOrdering& ordering);
 
+    /// Switch to the compact representation if the row indexes are in
+    /// ascending order and dense enough that a RowBitmap is the more
+    /// economical choice. Rows are then decoded lazily on access. If the
+    /// representation is already compact, the row indexes in m_row_indexes
+    /// are moved into the bitmap instead, which allows a result to be
+    /// gathered in batches without ever holding all of it in plain form. They
+    /// must then all be greater than the rows already in the bitmap.
+    void compact_row_indexes();
+
+    /// Switch back to the plain representation. This must be done before
+    /// m_row_indexes is modified, or handed out to code that accesses it
+    /// directly. If this function throws, the view is left unchanged.
+    void materialize_row_indexes();
+
+    /// Fill `rows`, which must be empty, with the row indexes held in the
+    /// compact representation.
+    void decode_row_bitmap(IntegerColumn& rows) const;
+
+    /// Set the row indexes, which must be empty, to the members of `rows`,
+    /// choosing the representation the same way as compact_row_indexes().
+    void assign_row_bitmap(const RowBitmap& rows);
+
+    /// Bring the row indexes up to date after the contents of the rows in
+    /// `changed` have changed, where `matches` are those of them that are
+    /// now to be included. Both must be in ascending order. The row indexes
+    /// must either be in table order, in which case `ordering` is empty, or
+    /// ordered by the single sort of `ordering`. Detached entries are
+    /// removed.
+    void apply_row_changes(const std::vector<size_t>& changed, const std::vector<size_t>& matches,
+                           const DescriptorOrdering& ordering);
+
+    // Compact representation of the row indexes. When set, m_row_indexes is
+    // empty, and the row indexes are the members of the bitmap in ascending
+    // order.
+    std::unique_ptr<RowBitmap> m_row_bitmap;
+
+    // Remembers the last position decoded from m_row_bitmap, such that
+    // sequential access does not have to search the bitmap.
+    mutable RowBitmap::const_iterator m_bitmap_cursor;
+    mutable size_t m_bitmap_cursor_ndx = npos;
+
+    // Results with fewer rows than this are never stored compactly
+    static const size_t compact_min_size = 4096;
+    // Results are only stored compactly if, on average, at least one in this
+    // many rows in their range is included
+    static const size_t compact_max_sparseness = 16;
+
     static const uint64_t cookie_expected = 0x7765697677777777ull; // 0x77656976 = 'view'; 0x77777777 = '7777' = alive
     uint64_t m_debug_cookie;
 };
 
+
+// Implementation:
+
+inline int64_t RowIndexes::get_row_index(size_t ndx) const noexcept
+{
+    if (REALM_LIKELY(!m_row_bitmap))
+        return m_row_indexes.get(ndx);
+
+    if (m_bitmap_cursor_ndx != npos && ndx == m_bitmap_cursor_ndx + 1) {
+        ++m_bitmap_cursor;
+    }
+    else if (m_bitmap_cursor_ndx != npos && ndx + 1 == m_bitmap_cursor_ndx) {
+        --m_bitmap_cursor;
+    }
+    else if (ndx != m_bitmap_cursor_ndx) {
+        m_bitmap_cursor = m_row_bitmap->select(ndx);
+    }
+    m_bitmap_cursor_ndx = ndx;
+    return int64_t(*m_bitmap_cursor);
+}
+
 } // namespace realm
 
 #endif // REALM_VIEWS_HPP
@@ -57,11 +57,13 @@ enum DetachOrder { AttachOrder, RevAttOrder, RandomOrder };
 ///       }
 ///     }
 ///
+/// `R` is the type of row accessor, either `Row` or the untracked `RowHandle`.
+template <class R>
 void heap(Timer& timer, BenchmarkResults& results, int n, const char* ident, const char* lead_text)
 {
     Table table;
     table.add_empty_row();
-    std::unique_ptr<Row[]> rows(new Row[n]);
+    std::unique_ptr<R[]> rows(new R[n]);
     for (int i = 0; i < n; ++i)
         rows[i] = table[0];
 
@@ -141,10 +143,15 @@ int main()
     Timer timer_total(Timer::type_UserTime);
     Timer timer(Timer::type_UserTime);
 
-    heap(timer, results, 1, "heap_1", "Heap 1");
-    heap(timer, results, 10, "heap_10", "Heap 10");
-    heap(timer, results, 100, "heap_100", "Heap 100");
-    heap(timer, results, 1000, "heap_1000", "Heap 1000");
+    heap<Row>(timer, results, 1, "heap_1", "Heap 1");
+    heap<Row>(timer, results, 10, "heap_10", "Heap 10");
+    heap<Row>(timer, results, 100, "heap_100", "Heap 100");
+    heap<Row>(timer, results, 1000, "heap_1000", "Heap 1000");
+
+    heap<RowHandle>(timer, results, 1, "handle_heap_1", "Handle heap 1");
+    heap<RowHandle>(timer, results, 10, "handle_heap_10", "Handle heap 10");
+    heap<RowHandle>(timer, results, 100, "handle_heap_100", "Handle heap 100");
+    heap<RowHandle>(timer, results, 1000, "handle_heap_1000", "Handle heap 1000");
 
     balloon(timer, results, 10, AttachOrder, "balloon_10", "Balloon 10");
     balloon(timer, results, 10, RevAttOrder, "balloon_10_reverse", "Balloon 10 (reverse)");
@@ -11866,6 +11866,102 @@ TEST(LangBindHelper_HandoverFuzzyTest)
 }
 
 
+TEST(LangBindHelper_AdvanceReadTransact_IncrementalTableViewSync)
+{
+    SHARED_GROUP_TEST_PATH(path);
+    Random random(random_int<unsigned long>()); // Seed from slow global generator
+
+    std::unique_ptr<Replication> hist_w(make_in_realm_history(path));
+    SharedGroup sg_w(*hist_w, SharedGroupOptions(crypt_key()));
+    {
+        WriteTransaction wt(sg_w);
+        TableRef table = wt.add_table("table");
+        table->add_column(type_Int, "a");
+        table->add_column(type_Int, "b");
+        table->add_empty_row(10000);
+        for (size_t i = 0; i < 10000; ++i) {
+            table->set_int(0, i, random.draw_int_mod(100));
+            table->set_int(1, i, random.draw_int_mod(1000));
+        }
+        wt.commit();
+    }
+
+    std::unique_ptr<Replication> hist_r(make_in_realm_history(path));
+    SharedGroup sg_r(*hist_r, SharedGroupOptions(crypt_key()));
+    ReadTransaction rt(sg_r);
+    ConstTableRef table = rt.get_table("table");
+
+    TableView sparse = table->where().greater(0, 90).find_all();
+    TableView sorted = table->where().greater(0, 90).find_all();
+    sorted.sort(1);
+    TableView dense = table->where().less(0, 90).find_all();
+    CHECK(dense.is_compact());
+
+    auto check_view = [&](TableView& view, Query query, bool sort) {
+        TableView expected = query.find_all();
+        if (sort)
+            expected.sort(1);
+        CHECK(view.is_in_sync());
+        if (!CHECK_EQUAL(expected.size(), view.size()))
+            return;
+        for (size_t i = 0; i < view.size(); ++i)
+            CHECK_EQUAL(expected.get_source_ndx(i), view.get_source_ndx(i));
+    };
+
+    for (int iter = 0; iter < 20; ++iter) {
+        // The compact view survives appends and modifications, but has to be
+        // rebuilt when rows are inserted or removed in front of its last row
+        bool only_appends = iter % 2 == 0;
+        {
+            WriteTransaction wt(sg_w);
+            TableRef t = wt.get_table("table");
+            for (int i = 0; i < 10; ++i) {
+                size_t row_ndx = random.draw_int_mod(t->size());
+                t->set_int(0, row_ndx, random.draw_int_mod(100));
+                t->set_int(1, row_ndx, random.draw_int_mod(1000));
+            }
+            size_t row_ndx = t->add_empty_row();
+            t->set_int(0, row_ndx, random.draw_int_mod(100));
+            if (!only_appends) {
+                t->move_last_over(random.draw_int_mod(t->size()));
+                t->remove(random.draw_int_mod(t->size()));
+                row_ndx = random.draw_int_mod(t->size());
+                t->insert_empty_row(row_ndx);
+                t->set_int(0, row_ndx, 95);
+            }
+            wt.commit();
+        }
+        LangBindHelper::advance_read(sg_r);
+
+        CHECK(!sparse.is_in_sync());
+        CHECK(sparse.can_sync_incrementally());
+        CHECK(sorted.can_sync_incrementally());
+        CHECK_EQUAL(only_appends, dense.can_sync_incrementally());
+
+        sparse.sync_if_needed();
+        sorted.sync_if_needed();
+        dense.sync_if_needed();
+        check_view(sparse, table->where().greater(0, 90), false);
+        check_view(sorted, table->where().greater(0, 90), true);
+        check_view(dense, table->where().less(0, 90), false);
+        CHECK(dense.is_compact());
+    }
+
+    // Changes made through a write transaction of the same session are not
+    // recorded, so the query is rerun
+    LangBindHelper::promote_to_write(sg_r);
+    const_cast<Group&>(rt.get_group()).get_table("table")->set_int(0, 0, 95);
+    LangBindHelper::commit_and_continue_as_read(sg_r);
+    CHECK(!sparse.can_sync_incrementally());
+    sparse.sync_if_needed();
+    check_view(sparse, table->where().greater(0, 90), false);
+
+    // Distinct views are always synced by rerunning the query
+    sorted.distinct(1);
+    CHECK(!sorted.can_sync_incrementally());
+}
+
+
 // TableView::clear() was originally reported to be slow when table was indexed and had links, but performance
 // has now doubled. This test is just a short sanity test that clear() still works.
 TEST(LangBindHelper_TableViewClear)
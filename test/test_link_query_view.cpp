@@ -2037,4 +2037,95 @@ TEST(BackLink_Query_MultipleLevelsAndTables)
     CHECK_TABLE_VIEW(q.find_all(), {1});
 }
 
+// Conditions on columns of linked tables that many rows link to are evaluated
+// as semijoins. Check them against the conditions evaluated row by row.
+TEST(LinkList_QuerySemiJoin)
+{
+    Group group;
+
+    TableRef customers = group.add_table("customers");
+    TableRef orders = group.add_table("orders");
+
+    size_t col_country = customers->add_column(type_String, "country", true);
+    size_t col_rating = customers->add_column(type_Int, "rating", true);
+    const char* countries[] = {"DE", "DK", "SE", "NO", "FI", "US", "GB", "FR", "ES", "IT"};
+    customers->add_empty_row(50);
+    for (size_t i = 0; i < 50; ++i) {
+        if (i % 11 != 0)
+            customers->set_string(col_country, i, countries[i % 10]);
+        if (i % 7 != 0)
+            customers->set_int(col_rating, i, int64_t(i % 5));
+    }
+
+    size_t col_customer = orders->add_column_link(type_Link, "customer", *customers);
+    size_t col_customers = orders->add_column_link(type_LinkList, "customers", *customers);
+    orders->add_empty_row(1000);
+    for (size_t i = 0; i < 1000; ++i) {
+        if (i % 13 != 0)
+            orders->set_link(col_customer, i, (i * 7) % 50);
+        LinkViewRef list = orders->get_linklist(col_customers, i);
+        for (size_t j = 0; j < i % 4; ++j)
+            list->add((i + j * 17) % 50);
+    }
+
+    auto check = [&](Query q, auto customer_matches, bool null_matches) {
+        TableView tv = q.find_all();
+        std::vector<size_t> expected;
+        for (size_t i = 0; i < 1000; ++i) {
+            if (orders->is_null_link(col_customer, i) ? null_matches
+                                                      : customer_matches(orders->get_link(col_customer, i)))
+                expected.push_back(i);
+        }
+        CHECK_EQUAL(tv.size(), expected.size());
+        for (size_t i = 0; i < tv.size() && i < expected.size(); ++i)
+            CHECK_EQUAL(tv.get_source_ndx(i), expected[i]);
+        CHECK_EQUAL(q.count(), expected.size());
+    };
+    auto country = [&](size_t row) { return customers->get_string(col_country, row); };
+    auto rating_is = [&](size_t row, int64_t value) {
+        return !customers->is_null(col_rating, row) && customers->get_int(col_rating, row) == value;
+    };
+
+    // Selective conditions, evaluated through backlinks
+    check(orders->link(col_customer).column<String>(col_country) == "DE",
+          [&](size_t row) { return country(row) == "DE"; }, false);
+    check(orders->link(col_customer).column<Int>(col_rating) == 10, [&](size_t) { return false; }, false);
+
+    // Conditions that match many rows, evaluated by following links
+    check(orders->link(col_customer).column<String>(col_country) != "DE",
+          [&](size_t row) { return country(row) != "DE"; }, true);
+    check(orders->link(col_customer).column<Int>(col_rating) > 1,
+          [&](size_t row) { return rating_is(row, 2) || rating_is(row, 3) || rating_is(row, 4); }, false);
+    check(orders->link(col_customer).column<String>(col_country).begins_with("D"),
+          [&](size_t row) { return country(row).begins_with("D"); }, false);
+
+    // Null links match conditions on null
+    check(orders->link(col_customer).column<String>(col_country) == realm::null(),
+          [&](size_t row) { return country(row).is_null(); }, true);
+    check(orders->link(col_customer).column<Int>(col_rating) == null(),
+          [&](size_t row) { return customers->is_null(col_rating, row); }, true);
+
+    // A row matches if any of the rows in its link list does
+    Query q = orders->link(col_customers).column<String>(col_country) == "SE";
+    TableView tv = q.find_all();
+    size_t num_matches = 0;
+    for (size_t i = 0; i < 1000; ++i) {
+        LinkViewRef list = orders->get_linklist(col_customers, i);
+        bool match = false;
+        for (size_t j = 0; j < list->size(); ++j)
+            match = match || country(list->get(j).get_index()) == "SE";
+        if (match) {
+            CHECK_EQUAL(tv.get_source_ndx(num_matches), i);
+            ++num_matches;
+        }
+    }
+    CHECK_EQUAL(tv.size(), num_matches);
+
+    // Combined with other conditions
+    q = orders->where();
+    q.Not().and_query(orders->link(col_customer).column<String>(col_country) == "DE");
+    q.and_query(orders->link(col_customer).column<Int>(col_rating) == 1);
+    check(q, [&](size_t row) { return country(row) != "DE" && rating_is(row, 1); }, false);
+}
+
 #endif
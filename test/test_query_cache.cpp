@@ -0,0 +1,270 @@
+/*************************************************************************
+ *
+ * Copyright 2016 Realm Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ **************************************************************************/
+
+#include "testsettings.hpp"
+#ifdef TEST_QUERY_CACHE
+
+#include <memory>
+
+#include <realm.hpp>
+#include <realm/history.hpp>
+#include <realm/lang_bind_helper.hpp>
+#include <realm/query_cache.hpp>
+
+#include "test.hpp"
+
+using namespace realm;
+using namespace realm::test_util;
+using unit_test::TestContext;
+
+// Test independence and thread-safety
+// -----------------------------------
+//
+// All tests must be thread safe and independent of each other. This
+// is required because it allows for both shuffling of the execution
+// order and for parallelized testing.
+//
+// In particular, avoid using std::rand() since it is not guaranteed
+// to be thread safe. Instead use the API offered in
+// `test/util/random.hpp`.
+//
+// All files created in tests must use the TEST_PATH macro (or one of
+// its friends) to obtain a suitable file system path. See
+// `test/util/test_path.hpp`.
+//
+//
+// Debugging and the ONLY() macro
+// ------------------------------
+//
+// A simple way of disabling all tests except one called `Foo`, is to
+// replace TEST(Foo) with ONLY(Foo) and then recompile and rerun the
+// test suite. Note that you can also use filtering by setting the
+// environment varible `UNITTEST_FILTER`. See `README.md` for more on
+// this.
+//
+// Another way to debug a particular test, is to copy that test into
+// `experiments/testcase.cpp` and then run `sh build.sh
+// check-testcase` (or one of its friends) from the command line.
+
+namespace {
+
+QueryResultCache::Result make_result(size_t first, size_t num_rows)
+{
+    std::shared_ptr<RowBitmap> rows = std::make_shared<RowBitmap>();
+    for (size_t i = 0; i < num_rows; ++i)
+        rows->add(first + i);
+    return rows;
+}
+
+} // anonymous namespace
+
+
+TEST(QueryCache_LookupAndInsert)
+{
+    QueryResultCache cache;
+    cache.retain_version(1);
+    CHECK(!cache.lookup(1, 0, "a == 1"));
+
+    cache.insert(1, 0, "a == 1", make_result(0, 10));
+    CHECK_EQUAL(cache.size(), 1);
+    QueryResultCache::Result result = cache.lookup(1, 0, "a == 1");
+    CHECK(result);
+    CHECK_EQUAL(result->size(), 10);
+
+    // All parts of the key must match
+    CHECK(!cache.lookup(2, 0, "a == 1"));
+    CHECK(!cache.lookup(1, 1, "a == 1"));
+    CHECK(!cache.lookup(1, 0, "a == 2"));
+
+    // The first result inserted for a key is kept
+    cache.insert(1, 0, "a == 1", make_result(0, 5));
+    CHECK_EQUAL(cache.lookup(1, 0, "a == 1")->size(), 10);
+
+    // Results for versions that are not bound are not cached
+    cache.insert(2, 0, "a == 1", make_result(0, 10));
+    CHECK(!cache.lookup(2, 0, "a == 1"));
+    CHECK_EQUAL(cache.size(), 1);
+}
+
+
+TEST(QueryCache_ReleaseVersion)
+{
+    QueryResultCache cache;
+    cache.retain_version(1);
+    cache.retain_version(1);
+    cache.retain_version(2);
+    cache.insert(1, 0, "a == 1", make_result(0, 10));
+    cache.insert(1, 1, "a == 1", make_result(0, 10));
+    cache.insert(2, 0, "a == 1", make_result(0, 10));
+    CHECK_EQUAL(cache.size(), 3);
+
+    // Results are kept until the last reader of the version releases it
+    cache.release_version(1);
+    CHECK_EQUAL(cache.size(), 3);
+    cache.release_version(1);
+    CHECK_EQUAL(cache.size(), 1);
+    CHECK(!cache.lookup(1, 0, "a == 1"));
+    CHECK(!cache.lookup(1, 1, "a == 1"));
+    CHECK(cache.lookup(2, 0, "a == 1"));
+
+    cache.release_version(2);
+    CHECK_EQUAL(cache.size(), 0);
+    CHECK_EQUAL(cache.get_memory_usage(), 0);
+}
+
+
+TEST(QueryCache_MemoryLimit)
+{
+    QueryResultCache cache;
+    cache.retain_version(1);
+    cache.insert(1, 0, "a == 1", make_result(0, 10));
+    size_t memory = cache.get_memory_usage();
+    CHECK_NOT_EQUAL(memory, 0);
+
+    // Room for two results of the same size
+    cache.set_max_memory(memory * 2);
+    cache.insert(1, 0, "a == 2", make_result(0, 10));
+    CHECK_EQUAL(cache.size(), 2);
+
+    // The least recently used result is evicted first
+    CHECK(cache.lookup(1, 0, "a == 1"));
+    cache.insert(1, 0, "a == 3", make_result(0, 10));
+    CHECK_EQUAL(cache.size(), 2);
+    CHECK(cache.lookup(1, 0, "a == 1"));
+    CHECK(!cache.lookup(1, 0, "a == 2"));
+    CHECK(cache.lookup(1, 0, "a == 3"));
+    CHECK(cache.get_memory_usage() <= cache.get_max_memory());
+
+    // Results that are larger than the limit are never cached
+    cache.insert(1, 0, "a == 4", make_result(0, 1000000));
+    CHECK(!cache.lookup(1, 0, "a == 4"));
+    CHECK_EQUAL(cache.size(), 2);
+
+    cache.set_max_memory(memory);
+    CHECK_EQUAL(cache.size(), 1);
+    CHECK(cache.lookup(1, 0, "a == 3"));
+
+    cache.clear();
+    CHECK_EQUAL(cache.size(), 0);
+    CHECK_EQUAL(cache.get_memory_usage(), 0);
+}
+
+
+#if REALM_METRICS
+
+TEST(QueryCache_SharedGroups)
+{
+    SHARED_GROUP_TEST_PATH(path);
+    std::unique_ptr<Replication> hist_1(make_in_realm_history(path));
+    std::unique_ptr<Replication> hist_2(make_in_realm_history(path));
+    std::unique_ptr<Replication> hist_w(make_in_realm_history(path));
+    SharedGroupOptions options(crypt_key());
+    options.enable_metrics = true;
+    options.query_cache = std::make_shared<QueryResultCache>();
+    SharedGroup sg_1(*hist_1, options);
+    SharedGroup sg_2(*hist_2, options);
+    SharedGroup sg_w(*hist_w, SharedGroupOptions(crypt_key()));
+    QueryResultCache& cache = *options.query_cache;
+
+    {
+        WriteTransaction wt(sg_w);
+        TableRef table = wt.add_table("table");
+        table->add_column(type_Int, "int");
+        table->add_column(type_Double, "double");
+        table->add_empty_row(1000);
+        for (size_t i = 0; i < 1000; ++i) {
+            table->set_int(0, i, i % 7);
+            table->set_double(1, i, 0.1 * double(i % 3));
+        }
+        wt.commit();
+    }
+
+    const Group& g_1 = sg_1.begin_read();
+    const Group& g_2 = sg_2.begin_read();
+    ConstTableRef table_1 = g_1.get_table("table");
+    ConstTableRef table_2 = g_2.get_table("table");
+
+    TableView tv_1 = table_1->where().equal(0, 3).find_all();
+    CHECK_EQUAL(cache.size(), 1);
+    CHECK_EQUAL(sg_1.get_metrics()->num_query_cache_misses(), 1);
+
+    // Another reader of the same snapshot gets the shared result
+    TableView tv_2 = table_2->where().equal(0, 3).find_all();
+    CHECK_EQUAL(cache.size(), 1);
+    CHECK_EQUAL(sg_2.get_metrics()->num_query_cache_hits(), 1);
+    CHECK_EQUAL(tv_1.size(), tv_2.size());
+    for (size_t i = 0; i < tv_1.size(); ++i)
+        CHECK_EQUAL(tv_1.get_source_ndx(i), tv_2.get_source_ndx(i));
+
+    // Sorting is applied to the shared result
+    TableView tv_3 = table_2->where().equal(0, 3).find_all();
+    tv_3.sort(1, false);
+    for (size_t i = 1; i < tv_3.size(); ++i)
+        CHECK_GREATER_EQUAL(tv_3.get_double(1, i - 1), tv_3.get_double(1, i));
+    CHECK_EQUAL(sg_2.get_metrics()->num_query_cache_hits(), 2);
+
+    // Queries that differ only in a floating point value are different
+    TableView tv_4 = table_1->where().equal(1, 0.1).find_all();
+    TableView tv_5 = table_2->where().equal(1, 0.1000000001).find_all();
+    CHECK_NOT_EQUAL(tv_4.size(), 0);
+    CHECK_EQUAL(tv_5.size(), 0);
+    CHECK_EQUAL(cache.size(), 3);
+
+    // Limited queries are not cached
+    table_1->where().equal(0, 3).find_all(0, size_t(-1), 10);
+    CHECK_EQUAL(cache.size(), 3);
+
+    // A new snapshot does not see the results of an older one, which are
+    // evicted when it is no longer bound by any reader
+    {
+        WriteTransaction wt(sg_w);
+        wt.get_table("table")->set_int(0, 0, 3);
+        wt.commit();
+    }
+    sg_1.end_read();
+    CHECK_EQUAL(cache.size(), 3);
+    sg_2.end_read();
+    CHECK_EQUAL(cache.size(), 0);
+
+    sg_1.begin_read();
+    table_1 = g_1.get_table("table");
+    TableView tv_6 = table_1->where().equal(0, 3).find_all();
+    CHECK_EQUAL(tv_6.size(), tv_1.size() + 1);
+    CHECK_EQUAL(sg_1.get_metrics()->num_query_cache_hits(), 0);
+
+    // Advancing the read transaction also releases the old snapshot
+    {
+        WriteTransaction wt(sg_w);
+        wt.get_table("table")->set_int(0, 1, 3);
+        wt.commit();
+    }
+    LangBindHelper::advance_read(sg_1);
+    CHECK_EQUAL(cache.size(), 0);
+    tv_6.sync_if_needed();
+    CHECK_EQUAL(tv_6.size(), tv_1.size() + 2);
+    sg_1.end_read();
+
+    // Nothing is cached in write transactions
+    WriteTransaction wt(sg_1);
+    wt.get_table("table")->where().equal(0, 3).find_all();
+    CHECK_EQUAL(cache.size(), 0);
+}
+
+#endif // REALM_METRICS
+
+#endif // TEST_QUERY_CACHE
@@ -0,0 +1,206 @@
+/*************************************************************************
+ *
+ * Copyright 2016 Realm Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ **************************************************************************/
+
+#include "testsettings.hpp"
+#ifdef TEST_ROW_BITMAP
+
+#include <algorithm>
+#include <set>
+#include <vector>
+
+#include <realm/array.hpp>
+#include <realm/row_bitmap.hpp>
+
+#include "test.hpp"
+
+using namespace realm;
+using namespace realm::test_util;
+using unit_test::TestContext;
+
+// Test independence and thread-safety
+// -----------------------------------
+//
+// All tests must be thread safe and independent of each other. This
+// is required because it allows for both shuffling of the execution
+// order and for parallelized testing.
+//
+// In particular, avoid using std::rand() since it is not guaranteed
+// to be thread safe. Instead use the API offered in
+// `test/util/random.hpp`.
+//
+// All files created in tests must use the TEST_PATH macro (or one of
+// its friends) to obtain a suitable file system path. See
+// `test/util/test_path.hpp`.
+//
+//
+// Debugging and the ONLY() macro
+// ------------------------------
+//
+// A simple way of disabling all tests except one called `Foo`, is to
+// replace TEST(Foo) with ONLY(Foo) and then recompile and rerun the
+// test suite. Note that you can also use filtering by setting the
+// environment varible `UNITTEST_FILTER`. See `README.md` for more on
+// this.
+//
+// Another way to debug a particular test, is to copy that test into
+// `experiments/testcase.cpp` and then run `sh build.sh
+// check-testcase` (or one of its friends) from the command line.
+
+namespace {
+
+// Check that `bitmap` holds exactly the members of `expected`, through all of
+// its access paths.
+void check_members(TestContext& test_context, const RowBitmap& bitmap, const std::set<size_t>& expected)
+{
+    bitmap.verify();
+    CHECK_EQUAL(bitmap.size(), expected.size());
+    CHECK_EQUAL(bitmap.empty(), expected.empty());
+    CHECK(std::equal(expected.begin(), expected.end(), bitmap.begin()));
+    CHECK_EQUAL(std::distance(bitmap.begin(), bitmap.end()), expected.size());
+
+    size_t ndx = 0;
+    for (size_t row_ndx : expected) {
+        CHECK(bitmap.contains(row_ndx));
+        CHECK_EQUAL(bitmap.rank(row_ndx), ndx);
+        CHECK_EQUAL(bitmap.find(row_ndx), ndx);
+        CHECK_EQUAL(*bitmap.select(ndx), row_ndx);
+        ++ndx;
+    }
+    CHECK(bitmap.select(ndx) == bitmap.end());
+
+    // Iterate backwards from the end
+    auto i = bitmap.end();
+    for (auto j = expected.rbegin(); j != expected.rend(); ++j) {
+        --i;
+        CHECK_EQUAL(*i, *j);
+    }
+    CHECK(i == bitmap.begin());
+}
+
+} // anonymous namespace
+
+
+TEST(RowBitmap_Empty)
+{
+    RowBitmap bitmap;
+    check_members(test_context, bitmap, {});
+    CHECK(!bitmap.contains(0));
+    CHECK_EQUAL(bitmap.rank(1000), 0);
+    CHECK_EQUAL(bitmap.find(0), not_found);
+    CHECK(bitmap.begin() == bitmap.end());
+}
+
+
+TEST(RowBitmap_AddSparse)
+{
+    RowBitmap bitmap;
+    std::set<size_t> expected;
+    for (size_t i = 0; i < 300000; i += 97) {
+        bitmap.add(i);
+        expected.insert(i);
+    }
+    check_members(test_context, bitmap, expected);
+    CHECK(!bitmap.contains(1));
+    CHECK_EQUAL(bitmap.find(1), not_found);
+    CHECK_EQUAL(bitmap.rank(98), 2);
+}
+
+
+TEST(RowBitmap_AddDense)
+{
+    RowBitmap bitmap;
+    std::set<size_t> expected;
+    // Crosses the threshold from sorted array to bitset in several chunks
+    for (size_t i = 0; i < 200000; ++i) {
+        if (i % 3 != 0) {
+            bitmap.add(i);
+            expected.insert(i);
+        }
+    }
+    check_members(test_context, bitmap, expected);
+
+    // Adding a member again is a no-op
+    bitmap.add(1);
+    bitmap.add(199999);
+    check_members(test_context, bitmap, expected);
+}
+
+
+TEST(RowBitmap_AddRandomOrder)
+{
+    Random random(random_int<unsigned long>()); // Seed from slow global generator
+    RowBitmap bitmap;
+    std::set<size_t> expected;
+    for (size_t i = 0; i < 20000; ++i) {
+        size_t row_ndx = random.draw_int_mod<size_t>(400000);
+        bitmap.add(row_ndx);
+        expected.insert(row_ndx);
+    }
+    check_members(test_context, bitmap, expected);
+}
+
+
+TEST(RowBitmap_AddRange)
+{
+    RowBitmap bitmap;
+    std::set<size_t> expected;
+    bitmap.add(5);
+    bitmap.add(70000);
+    bitmap.add_range(10, 20);
+    bitmap.add_range(60000, 140000);
+    bitmap.add_range(139990, 140010);
+    bitmap.add_range(200, 200);
+    expected.insert(5);
+    for (size_t i = 10; i < 20; ++i)
+        expected.insert(i);
+    for (size_t i = 60000; i < 140010; ++i)
+        expected.insert(i);
+    check_members(test_context, bitmap, expected);
+}
+
+
+TEST(RowBitmap_Equality)
+{
+    RowBitmap a, b;
+    a.add_range(0, 100000);
+    for (size_t i = 0; i < 100000; ++i)
+        b.add(i);
+    CHECK(a == b);
+    b.add(200000);
+    CHECK(a != b);
+    a.add(200000);
+    CHECK(a == b);
+    RowBitmap c = a;
+    c.add(200001);
+    CHECK(a != c);
+}
+
+
+TEST(RowBitmap_MemoryUsage)
+{
+    // A dense set must be much smaller than one 64-bit index per member
+    RowBitmap bitmap;
+    bitmap.add_range(0, 1000000);
+    CHECK_EQUAL(bitmap.size(), 1000000);
+    CHECK_LESS(bitmap.memory_usage(), 1000000 / 4);
+
+    bitmap.clear();
+    check_members(test_context, bitmap, {});
+}
+
+#endif // TEST_ROW_BITMAP
@@ -21,12 +21,14 @@
 
 #include <algorithm>
 #include <limits>
+#include <map>
 #include <string>
 #include <fstream>
 #include <ostream>
 
 #include <realm.hpp>
 #include <realm/history.hpp>
+#include <realm/impl/column_reader.hpp>
 #include <realm/lang_bind_helper.hpp>
 #include <realm/util/buffer.hpp>
 #include <realm/util/to_string.hpp>
@@ -4733,6 +4735,172 @@ TEST(Table_Pivot)
 }
 
 
+TEST(Table_GroupedAggregate)
+{
+    Group group;
+    TableRef teams = group.add_table("teams");
+    teams->add_column(type_String, "name");
+    teams->add_empty_row(3);
+    TableRef table = group.add_table("people");
+    table->add_column(type_String, "sex", true);
+    table->add_column(type_Bool, "hired");
+    table->add_column(type_Int, "age", true);
+    table->add_column(type_Double, "score");
+    table->add_column(type_Float, "weight");
+    table->add_column_link(type_Link, "team", *teams);
+
+    size_t count = 1717;
+    table->add_empty_row(count);
+    for (size_t i = 0; i < count; ++i) {
+        if (i % 31 != 0)
+            table->set_string(0, i, i % 2 == 0 ? "Male" : "Female");
+        table->set_bool(1, i, i % 3 == 0);
+        if (i % 5 != 0)
+            table->set_int(2, i, int64_t(3 + i % 117));
+        table->set_double(3, i, double(i % 10) / 4);
+        table->set_float(4, i, float(50 + i % 41));
+        if (i % 7 != 0)
+            table->set_link(5, i, i % 3);
+    }
+
+    // The expected aggregates of each group, in order of first occurrence
+    struct Expected {
+        size_t first_row;
+        int64_t count = 0;
+        int64_t age_sum = 0;
+        int64_t age_count = 0;
+        int64_t age_min = 0;
+        int64_t age_max = 0;
+        double score_sum = 0;
+        float weight_max = 0;
+    };
+    auto expected_groups = [&](auto key, const std::vector<size_t>& rows) {
+        std::vector<Expected> groups;
+        std::map<std::string, size_t> group_ndxs;
+        for (size_t i : rows) {
+            auto j = group_ndxs.emplace(key(i), groups.size()).first;
+            if (j->second == groups.size()) {
+                groups.emplace_back();
+                groups.back().first_row = i;
+            }
+            Expected& e = groups[j->second];
+            ++e.count;
+            if (!table->is_null(2, i)) {
+                int64_t age = table->get_int(2, i);
+                e.age_min = (e.age_count == 0 || age < e.age_min ? age : e.age_min);
+                e.age_max = (e.age_count == 0 || age > e.age_max ? age : e.age_max);
+                e.age_sum += age;
+                ++e.age_count;
+            }
+            e.score_sum += table->get_double(3, i);
+            float weight = table->get_float(4, i);
+            e.weight_max = (e.count == 1 || weight > e.weight_max ? weight : e.weight_max);
+        }
+        return groups;
+    };
+    std::vector<Table::AggrSpec> aggregates = {{Table::aggr_count, npos},  {Table::aggr_sum, 2},
+                                               {Table::aggr_min, 2},       {Table::aggr_max, 2},
+                                               {Table::aggr_avg, 2},       {Table::aggr_sum, 3},
+                                               {Table::aggr_max, 4}};
+    auto check_aggregates = [&](const Table& result, size_t col, const std::vector<Expected>& groups) {
+        CHECK_EQUAL(result.size(), groups.size());
+        for (size_t i = 0; i < groups.size() && i < result.size(); ++i) {
+            const Expected& e = groups[i];
+            CHECK_EQUAL(result.get_int(col, i), e.count);
+            CHECK_EQUAL(result.get_int(col + 1, i), e.age_sum);
+            CHECK_EQUAL(result.get_int(col + 2, i), e.age_min);
+            CHECK_EQUAL(result.get_int(col + 3, i), e.age_max);
+            CHECK_EQUAL(result.get_double(col + 4, i), double(e.age_sum) / double(e.age_count));
+            CHECK_EQUAL(result.get_double(col + 5, i), e.score_sum);
+            CHECK_EQUAL(result.get_float(col + 6, i), e.weight_max);
+        }
+    };
+
+    std::vector<size_t> all_rows(count);
+    for (size_t i = 0; i < count; ++i)
+        all_rows[i] = i;
+    auto sex_and_hired = [&](size_t i) {
+        return std::string(table->is_null(0, i) ? "null" : table->get_string(0, i)) +
+               (table->get_bool(1, i) ? "/hired" : "/not hired");
+    };
+
+    for (int i = 0; i < 2; ++i) {
+        Table result;
+        table->aggregate({0, 1}, aggregates, result);
+        CHECK_EQUAL(result.get_column_count(), 9);
+        CHECK_EQUAL(result.get_column_name(0), "sex");
+        CHECK_EQUAL(result.get_column_name(2), "COUNT()");
+        CHECK_EQUAL(result.get_column_name(3), "SUM(age)");
+        std::vector<Expected> groups = expected_groups(sex_and_hired, all_rows);
+        check_aggregates(result, 2, groups);
+        for (size_t j = 0; j < groups.size() && j < result.size(); ++j) {
+            CHECK_EQUAL(result.get_string(0, j), table->get_string(0, groups[j].first_row));
+            CHECK_EQUAL(result.get_bool(1, j), table->get_bool(1, groups[j].first_row));
+        }
+
+        // Test with enumerated strings in second loop
+        table->optimize();
+    }
+
+    // Link keys are given as the index of the target row
+    {
+        Table result;
+        table->aggregate({5}, aggregates, result);
+        auto team = [&](size_t i) {
+            return table->is_null_link(5, i) ? std::string("null") : util::to_string(table->get_link(5, i));
+        };
+        std::vector<Expected> groups = expected_groups(team, all_rows);
+        check_aggregates(result, 1, groups);
+        for (size_t j = 0; j < groups.size() && j < result.size(); ++j) {
+            size_t row = groups[j].first_row;
+            CHECK_EQUAL(result.is_null(0, j), table->is_null_link(5, row));
+            if (!table->is_null_link(5, row))
+                CHECK_EQUAL(result.get_int(0, j), int64_t(table->get_link(5, row)));
+        }
+    }
+
+    // Nullable integer keys, over the rows of a view
+    {
+        TableView view = table->where().greater_equal(3, 1.0).find_all();
+        Table result;
+        view.aggregate({2}, {{Table::aggr_count, npos}}, result);
+        std::map<int64_t, int64_t> counts;
+        int64_t null_count = 0;
+        for (size_t i = 0; i < view.size(); ++i) {
+            size_t row = view.get_source_ndx(i);
+            if (table->is_null(2, row)) {
+                ++null_count;
+            }
+            else {
+                ++counts[table->get_int(2, row)];
+            }
+        }
+        CHECK_EQUAL(result.size(), counts.size() + (null_count ? 1 : 0));
+        for (size_t i = 0; i < result.size(); ++i) {
+            int64_t expected = (result.is_null(0, i) ? null_count : counts[result.get_int(0, i)]);
+            CHECK_EQUAL(result.get_int(1, i), expected);
+        }
+    }
+
+    // Groups whose values are all null have null minimums and averages
+    {
+        TableRef empty = group.add_table("empty");
+        empty->add_column(type_String, "key");
+        empty->add_column(type_Int, "value", true);
+        empty->add_empty_row(2);
+        Table empty_result;
+        empty->aggregate({0}, {{Table::aggr_min, 1}, {Table::aggr_avg, 1}, {Table::aggr_sum, 1}}, empty_result);
+        CHECK_EQUAL(empty_result.size(), 1);
+        CHECK(empty_result.is_null(1, 0));
+        CHECK(empty_result.is_null(2, 0));
+        CHECK_EQUAL(empty_result.get_int(3, 0), 0);
+    }
+
+    Table result;
+    CHECK_LOGIC_ERROR(table->aggregate({3}, {}, result), LogicError::type_mismatch);
+}
+
+
 namespace {
 
 void compare_table_with_slice(TestContext& test_context, const Table& table, const Table& slice, size_t offset,
@@ -6338,6 +6506,218 @@ TEST(Table_RowAccessorDetach)
 }
 
 
+TEST(Table_BatchGetters)
+{
+    Random random(random_int<unsigned long>()); // Seed from slow global generator
+
+    Table table;
+    table.add_column(type_Int, "int");
+    table.add_column(type_Int, "int_null", true);
+    table.add_column(type_Double, "double", true);
+    table.add_column(type_Timestamp, "timestamp", true);
+    table.add_column(type_String, "string", true);
+    table.add_column(type_String, "enum");
+
+    const size_t num_rows = 2000;
+    table.add_empty_row(num_rows);
+    std::string medium(100, 'm');
+    std::string big(100000, 'b');
+    for (size_t i = 0; i < num_rows; ++i) {
+        table.set_int(0, i, random.draw_int<int64_t>());
+        if (i % 3 != 0)
+            table.set_int(1, i, int64_t(i));
+        if (i % 5 != 0)
+            table.set_double(2, i, double(i) / 3);
+        if (i % 7 != 0)
+            table.set_timestamp(3, i, Timestamp(int64_t(i) - 1000, 0));
+        if (i % 11 != 0) {
+            // Long strings make some of the leaves medium and big string leaves
+            std::string str = util::to_string(i);
+            if (i >= 1000 && i < 1200)
+                str += medium;
+            if (i == 1500)
+                str += big;
+            table.set_string(4, i, str);
+        }
+        table.set_string(5, i, i % 2 == 0 ? "even" : "odd");
+    }
+    table.optimize();
+
+    auto check_all = [&](size_t n, auto row_at, auto get_ints, auto get_doubles, auto get_timestamps,
+                         auto get_strings) {
+        std::vector<int64_t> ints(n);
+        std::vector<double> doubles(n);
+        std::vector<Timestamp> timestamps(n);
+        std::unique_ptr<StringData[]> strings(new StringData[n]);
+        for (size_t col = 0; col < 2; ++col) {
+            get_ints(col, ints.data());
+            for (size_t i = 0; i < n; ++i)
+                CHECK_EQUAL(ints[i], table.get_int(col, row_at(i)));
+        }
+        get_doubles(2, doubles.data());
+        for (size_t i = 0; i < n; ++i)
+            CHECK_EQUAL(doubles[i], table.get_double(2, row_at(i)));
+        get_timestamps(3, timestamps.data());
+        for (size_t i = 0; i < n; ++i)
+            CHECK(timestamps[i] == table.get_timestamp(3, row_at(i)));
+        for (size_t col = 4; col < 6; ++col) {
+            get_strings(col, strings.get());
+            for (size_t i = 0; i < n; ++i) {
+                StringData expected = table.get_string(col, row_at(i));
+                CHECK_EQUAL(strings[i].is_null(), expected.is_null());
+                CHECK_EQUAL(strings[i], expected);
+            }
+        }
+    };
+
+    // A range of rows
+    size_t begin = 300;
+    size_t end = 1700;
+    check_all(end - begin, [&](size_t i) { return begin + i; },
+              [&](size_t col, int64_t* out) { table.get_ints(col, begin, end, out); },
+              [&](size_t col, double* out) { table.get_doubles(col, begin, end, out); },
+              [&](size_t col, Timestamp* out) { table.get_timestamps(col, begin, end, out); },
+              [&](size_t col, StringData* out) { table.get_strings(col, begin, end, out); });
+
+    // Gathering rows in random order
+    std::vector<size_t> rows;
+    for (size_t i = 0; i < 1000; ++i)
+        rows.push_back(random.draw_int_mod(num_rows));
+    check_all(rows.size(), [&](size_t i) { return rows[i]; },
+              [&](size_t col, int64_t* out) { table.gather_ints(col, rows.data(), rows.size(), out); },
+              [&](size_t col, double* out) { table.gather_doubles(col, rows.data(), rows.size(), out); },
+              [&](size_t col, Timestamp* out) { table.gather_timestamps(col, rows.data(), rows.size(), out); },
+              [&](size_t col, StringData* out) { table.gather_strings(col, rows.data(), rows.size(), out); });
+
+    // The rows of a sorted view
+    TableView view = table.where().not_equal(5, "odd").find_all();
+    view.sort(0);
+    check_all(view.size(), [&](size_t i) { return view.get_source_ndx(i); },
+              [&](size_t col, int64_t* out) { view.get_ints(col, 0, view.size(), out); },
+              [&](size_t col, double* out) { view.get_doubles(col, 0, view.size(), out); },
+              [&](size_t col, Timestamp* out) { view.get_timestamps(col, 0, view.size(), out); },
+              [&](size_t col, StringData* out) { view.get_strings(col, 0, view.size(), out); });
+}
+
+
+TEST(Table_ColumnReader)
+{
+    Random random(random_int<unsigned long>()); // Seed from slow global generator
+
+    Group group; // type_LinkList must be part of a group
+    TableRef table = group.add_table("table");
+    table->add_column(type_Int, "int");
+    table->add_column(type_Int, "int_null", true);
+    table->add_column(type_Float, "float", true);
+    table->add_column(type_Double, "double");
+    table->add_column(type_String, "string", true);
+    table->add_column(type_String, "enum");
+    table->add_column(type_Binary, "binary", true);
+    table->add_column(type_Timestamp, "timestamp", true);
+    table->add_column_link(type_LinkList, "links", *table);
+
+    const size_t num_rows = 3000;
+    table->add_empty_row(num_rows);
+    std::string medium(100, 'm');
+    std::string big(100000, 'b');
+    for (size_t i = 0; i < num_rows; ++i) {
+        table->set_int(0, i, random.draw_int<int64_t>());
+        if (i % 3 != 0)
+            table->set_int(1, i, int64_t(i));
+        if (i % 5 != 0)
+            table->set_float(2, i, float(i) / 7);
+        table->set_double(3, i, double(i) / 3);
+        if (i % 11 != 0) {
+            // Long strings make some of the leaves medium and big leaves
+            std::string str = util::to_string(i);
+            if (i >= 1000 && i < 1200)
+                str += medium;
+            if (i == 2500)
+                str += big;
+            table->set_string(4, i, str);
+            table->set_binary(6, i, BinaryData(str));
+        }
+        table->set_string(5, i, i % 2 == 0 ? "even" : "odd");
+        if (i % 7 != 0)
+            table->set_timestamp(7, i, Timestamp(int64_t(i) - 1000, int32_t(i)));
+        for (size_t j = 0; j < i % 4; ++j)
+            table->get_linklist(8, i)->add(j);
+    }
+    table->optimize();
+
+    // Reads every row forwards through the iterators, and a sample of rows in
+    // random order, and checks that the values agree with the column
+    auto check_column = [&](auto& reader, auto& column, auto equal) {
+        CHECK_EQUAL(reader.size(), num_rows);
+        CHECK_EQUAL(reader.end() - reader.begin(), ptrdiff_t(num_rows));
+        size_t row = 0;
+        for (auto i = reader.begin(); i != reader.end(); ++i, ++row) {
+            CHECK_EQUAL(i.get_row_ndx(), row);
+            if (!equal(*i, row))
+                CHECK(equal(*i, row));
+            CHECK_EQUAL(reader.is_null(row), column.is_null(row));
+        }
+        for (size_t i = 0; i < 1000; ++i) {
+            row = random.draw_int_mod(num_rows);
+            CHECK(equal(reader.begin()[row], row));
+            CHECK_EQUAL(reader.is_null(row), column.is_null(row));
+        }
+    };
+
+    auto& ints = static_cast<IntegerColumn&>(_impl::TableFriend::get_column(*table, 0));
+    ColumnReader<IntegerColumn> int_reader(ints);
+    check_column(int_reader, ints, [&](int64_t v, size_t row) { return v == ints.get(row); });
+
+    auto& int_nulls = static_cast<IntNullColumn&>(_impl::TableFriend::get_column(*table, 1));
+    ColumnReader<IntNullColumn> int_null_reader(int_nulls);
+    check_column(int_null_reader, int_nulls,
+                 [&](util::Optional<int64_t> v, size_t row) { return v == int_nulls.get(row); });
+
+    auto& floats = static_cast<FloatColumn&>(_impl::TableFriend::get_column(*table, 2));
+    ColumnReader<FloatColumn> float_reader(floats);
+    check_column(float_reader, floats, [&](float v, size_t row) {
+        return floats.is_null(row) ? null::is_null_float(v) : v == floats.get(row);
+    });
+
+    auto& doubles = static_cast<DoubleColumn&>(_impl::TableFriend::get_column(*table, 3));
+    ColumnReader<DoubleColumn> double_reader(doubles);
+    check_column(double_reader, doubles, [&](double v, size_t row) { return v == doubles.get(row); });
+
+    auto& strings = static_cast<StringColumn&>(_impl::TableFriend::get_column(*table, 4));
+    ColumnReader<StringColumn> string_reader(strings);
+    check_column(string_reader, strings, [&](StringData v, size_t row) {
+        return v.is_null() == strings.get(row).is_null() && v == strings.get(row);
+    });
+
+    auto& enums = dynamic_cast<StringEnumColumn&>(_impl::TableFriend::get_column(*table, 5));
+    ColumnReader<StringEnumColumn> enum_reader(enums);
+    check_column(enum_reader, enums, [&](StringData v, size_t row) { return v == enums.get(row); });
+    CHECK_EQUAL(enum_reader.get_key(0), size_t(enums.IntegerColumn::get(0)));
+
+    auto& binaries = static_cast<BinaryColumn&>(_impl::TableFriend::get_column(*table, 6));
+    ColumnReader<BinaryColumn> binary_reader(binaries);
+    check_column(binary_reader, binaries, [&](BinaryData v, size_t row) {
+        return v.is_null() == binaries.get(row).is_null() && v == binaries.get(row);
+    });
+
+    auto& timestamps = static_cast<TimestampColumn&>(_impl::TableFriend::get_column(*table, 7));
+    ColumnReader<TimestampColumn> timestamp_reader(timestamps);
+    check_column(timestamp_reader, timestamps, [&](Timestamp v, size_t row) { return v == timestamps.get(row); });
+
+    auto& link_lists = static_cast<LinkListColumn&>(_impl::TableFriend::get_column(*table, 8));
+    ColumnReader<LinkListColumn> link_list_reader(link_lists);
+    check_column(link_list_reader, link_lists,
+                 [&](size_t v, size_t row) { return v == link_lists.get_link_count(row); });
+    CHECK_EQUAL(link_list_reader.get_ref(0), 0);
+    CHECK_EQUAL(link_list_reader.get_ref(3), link_lists.get_as_ref(3));
+
+    // The iterators work with the standard algorithms
+    ColumnReader<IntNullColumn> int_null_reader_2(int_nulls);
+    auto nulls = std::count(int_null_reader_2.begin(), int_null_reader_2.end(), util::Optional<int64_t>());
+    CHECK_EQUAL(nulls, ptrdiff_t(num_rows / 3));
+}
+
+
 TEST(Table_RowAccessor_DetachedRowExpr)
 {
     // Check that it is possible to create a detached RowExpr from scratch.
@@ -6346,6 +6726,74 @@ TEST(Table_RowAccessor_DetachedRowExpr)
 }
 
 
+TEST(Table_RowHandle)
+{
+    TableRef table = Table::create();
+    table->add_column(type_Int, "a");
+    table->add_empty_row(3);
+
+    RowHandle default_handle;
+    CHECK_NOT(default_handle.is_attached());
+
+    RowHandle row = (*table)[1];
+    CHECK(row.is_attached());
+    CHECK_EQUAL(table.get(), row.get_table());
+    CHECK_EQUAL(1, row.get_index());
+    row.set_int(0, 7);
+    CHECK_EQUAL(7, table->get_int(0, 1));
+    CHECK_EQUAL(7, row.get_int(0));
+
+    // Setting values and appending rows leaves handles valid
+    table->set_int(0, 0, 3);
+    table->add_empty_row();
+    CHECK(row.is_attached());
+    CHECK_EQUAL(7, row.get_int(0));
+
+    // Conversion from real row accessors and to const handles
+    Row real_row = (*table)[2];
+    RowHandle from_row = real_row;
+    ConstRowHandle const_row = row;
+    CHECK(from_row.is_attached());
+    CHECK_EQUAL(2, from_row.get_index());
+    CHECK(const_row.is_attached());
+    CHECK_EQUAL(7, const_row.get_int(0));
+
+    // Handles are not registered with the table, so, unlike real row
+    // accessors, they are not adjusted for an insertion before their row, but
+    // become detached
+    table->insert_empty_row(0);
+    CHECK_NOT(row.is_attached());
+    CHECK_NOT(const_row.is_attached());
+    CHECK_NOT(from_row.is_attached());
+    CHECK(real_row.is_attached());
+    CHECK_EQUAL(3, real_row.get_index());
+
+    row = (*table)[2];
+    CHECK(row.is_attached());
+    CHECK_EQUAL(7, row.get_int(0));
+    table->move_last_over(4);
+    CHECK_NOT(row.is_attached());
+
+    row = (*table)[2];
+    table->remove(0);
+    CHECK_NOT(row.is_attached());
+
+    row = (*table)[1];
+    table->clear();
+    CHECK_NOT(row.is_attached());
+
+    // The handle keeps the table accessor alive
+    table->add_empty_row();
+    row = (*table)[0];
+    Table* table_ptr = table.get();
+    table.reset();
+    CHECK(row.is_attached());
+    CHECK_EQUAL(table_ptr, row.get_table());
+    row.detach();
+    CHECK_NOT(row.is_attached());
+}
+
+
 TEST(Table_RowAccessorCopyAndAssign)
 {
     Table table;
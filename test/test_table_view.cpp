@@ -24,6 +24,7 @@
 #include <sstream>
 #include <ostream>
 #include <cwchar>
+#include <functional>
 
 #include <realm/group_shared.hpp>
 #include <realm/table_view.hpp>
@@ -3470,4 +3471,376 @@ TEST(TableView_TimestampMaxRemoveRow)
     CHECK_EQUAL(tv.maximum_timestamp(0), Timestamp(8, 0));
 }
 
+// Dense unsorted query results are stored in a compressed bitmap. Check that
+// this is transparent to users of the view.
+TEST(TableView_DenseResults)
+{
+    Table table;
+    table.add_column(type_Int, "int");
+    const size_t num_rows = 20000;
+    table.add_empty_row(num_rows);
+    for (size_t i = 0; i < num_rows; ++i)
+        table.set_int(0, i, i % 2);
+
+    TableView tv = table.where().equal(0, 1).find_all();
+    CHECK(tv.is_compact());
+    CHECK_EQUAL(tv.size(), num_rows / 2);
+    CHECK_EQUAL(tv.num_attached_rows(), num_rows / 2);
+    CHECK(!tv.is_empty());
+    CHECK(tv.is_in_sync());
+
+    // Sequential access
+    for (size_t i = 0; i < tv.size(); ++i)
+        CHECK_EQUAL(tv.get_source_ndx(i), 2 * i + 1);
+    // Backwards access
+    for (size_t i = tv.size(); i > 0; --i)
+        CHECK_EQUAL(tv.get_source_ndx(i - 1), 2 * i - 1);
+    // Random access
+    CHECK_EQUAL(tv.get_source_ndx(5000), 10001);
+    CHECK_EQUAL(tv.get_source_ndx(17), 35);
+    CHECK_EQUAL(tv.get_int(0, 9999), 1);
+
+    CHECK_EQUAL(tv.find_by_source_ndx(1), 0);
+    CHECK_EQUAL(tv.find_by_source_ndx(19999), 9999);
+    CHECK_EQUAL(tv.find_by_source_ndx(2), not_found);
+    CHECK_EQUAL(tv.sum_int(0), int64_t(num_rows / 2));
+    CHECK_EQUAL(tv.count_int(0, 1), num_rows / 2);
+
+    // Restricting a query by the view
+    CHECK_EQUAL(table.where(&tv).less(0, 1).count(), 0);
+    CHECK_EQUAL(table.where(&tv).find(2), 3);
+
+    // Copying and assignment preserve the representation
+    TableView copy = tv;
+    CHECK(copy.is_compact());
+    CHECK_EQUAL(copy.size(), num_rows / 2);
+    CHECK_EQUAL(copy.get_source_ndx(1234), 2469);
+    TableView assigned;
+    assigned = copy;
+    CHECK(assigned.is_compact());
+    CHECK_EQUAL(assigned.size(), num_rows / 2);
+    CHECK_EQUAL(assigned.get_source_ndx(1234), 2469);
+    TableView moved;
+    moved = std::move(assigned);
+    CHECK(moved.is_compact());
+    CHECK(moved.is_in_sync());
+    CHECK_EQUAL(moved.size(), num_rows / 2);
+    CHECK_EQUAL(moved.get_source_ndx(9999), 19999);
+
+    // Pivot aggregation leaves the representation alone
+    Table pivot;
+    table.add_column(type_String, "string");
+    tv.sync_if_needed();
+    CHECK(tv.is_compact());
+    tv.aggregate(1, 0, Table::aggr_count, pivot);
+    CHECK_EQUAL(pivot.size(), 1);
+    CHECK_EQUAL(pivot.get_int(1, 0), int64_t(num_rows / 2));
+    CHECK(tv.is_compact());
+
+    // Appending rows does not affect the view
+    table.add_empty_row();
+    CHECK(tv.is_compact());
+    CHECK_EQUAL(tv.size(), num_rows / 2);
+    CHECK_EQUAL(tv.get_source_ndx(9999), 19999);
+
+    // Removing a row inside the range of the view brings it out of sync, and
+    // the query is rerun on the next sync
+    table.remove(3);
+    CHECK(!tv.is_in_sync());
+    tv.sync_if_needed();
+    CHECK(tv.is_compact());
+    CHECK_EQUAL(tv.size(), num_rows / 2 - 1);
+    CHECK_EQUAL(tv.get_source_ndx(1), 4);
+
+    // Clearing the table empties the view in the same way
+    copy.sync_if_needed();
+    CHECK(copy.is_compact());
+
+    tv.sort(0, false);
+    CHECK(!tv.is_compact());
+    CHECK_EQUAL(tv.size(), num_rows / 2 - 1);
+    CHECK_EQUAL(tv.get_int(0, 0), 1);
+
+    // Modifying the view removes the rows from the table
+    TableView tv2 = table.where().equal(0, 0).find_all();
+    size_t num_zeros = tv2.size();
+    tv2.remove(0);
+    CHECK_EQUAL(tv2.size(), num_zeros - 1);
+    tv2.clear();
+    CHECK_EQUAL(tv2.size(), 0);
+    CHECK_EQUAL(table.size(), num_rows / 2 - 1);
+
+    table.clear();
+    CHECK(!copy.is_in_sync());
+    copy.sync_if_needed();
+    CHECK_EQUAL(copy.size(), 0);
+}
+
+
+// A compact view must survive handover, with and without moving its payload
+TEST(TableView_DenseResultsHandover)
+{
+    SHARED_GROUP_TEST_PATH(path);
+    SharedGroup sg(path, false, SharedGroupOptions(crypt_key()));
+    {
+        WriteTransaction wt(sg);
+        TableRef table = wt.add_table("table");
+        table->add_column(type_Int, "int");
+        table->add_empty_row(20000);
+        for (size_t i = 0; i < 20000; ++i)
+            table->set_int(0, i, i % 3 == 0 ? 0 : 1);
+        wt.commit();
+    }
+
+    Group& group = const_cast<Group&>(sg.begin_read());
+    SharedGroup::VersionID vid = sg.get_version_of_current_transaction();
+    TableRef table = group.get_table("table");
+    TableView tv = table->where().equal(0, 1).find_all();
+    CHECK(tv.is_compact());
+    size_t num_matches = tv.size();
+    auto handover_copy = sg.export_for_handover(tv, ConstSourcePayload::Copy);
+    CHECK(tv.is_in_sync());
+    auto handover_move = sg.export_for_handover(tv, MutableSourcePayload::Move);
+    CHECK(!tv.is_in_sync());
+
+    SharedGroup sg2(path, false, SharedGroupOptions(crypt_key()));
+    sg2.begin_read(vid);
+    std::unique_ptr<TableView> tv_copy(sg2.import_from_handover(std::move(handover_copy)));
+    std::unique_ptr<TableView> tv_move(sg2.import_from_handover(std::move(handover_move)));
+    for (TableView* view : {tv_copy.get(), tv_move.get()}) {
+        CHECK(view->is_compact());
+        CHECK(view->is_in_sync());
+        CHECK_EQUAL(view->size(), num_matches);
+        CHECK_EQUAL(view->get_source_ndx(0), 1);
+        CHECK_EQUAL(view->get_source_ndx(num_matches - 1), 19999);
+        CHECK_EQUAL(view->find_by_source_ndx(3), not_found);
+        CHECK_EQUAL(view->find_by_source_ndx(4), 2);
+    }
+}
+
+
+// Large single column sorts on integer, float, double and timestamp columns
+// are done by radix sorting keys. They must give the same order as sorting by
+// comparison, including the placement of nulls and null links and the order of
+// ties.
+TEST(TableView_SortLargeRadix)
+{
+    Random random(random_int<unsigned long>()); // Seed from slow global generator
+
+    Group g;
+    TableRef target = g.add_table("target");
+    TableRef origin = g.add_table("origin");
+    target->add_column(type_Int, "int");
+    origin->add_column(type_Int, "int");
+    origin->add_column(type_Int, "int_null", true);
+    origin->add_column(type_Bool, "bool");
+    origin->add_column(type_Float, "float", true);
+    origin->add_column(type_Double, "double");
+    origin->add_column(type_Timestamp, "timestamp", true);
+    origin->add_column_link(type_Link, "link", *target);
+
+    const size_t num_rows = 1000;
+    target->add_empty_row(10);
+    for (size_t i = 0; i < 10; ++i)
+        target->set_int(0, i, random.draw_int<int64_t>(-3, 3));
+    origin->add_empty_row(num_rows);
+    for (size_t i = 0; i < num_rows; ++i) {
+        origin->set_int(0, i, random.draw_int<int64_t>(-50, 50) * 1000000000000LL);
+        if (random.draw_bool())
+            origin->set_int(1, i, random.draw_int<int64_t>(-50, 50));
+        origin->set_bool(2, i, random.draw_bool());
+        if (random.draw_bool())
+            origin->set_float(3, i, float(random.draw_int<int>(-20, 20)) / 4);
+        if (i % 10 == 0)
+            origin->set_float(3, i, -0.0f);
+        origin->set_double(4, i, random.draw_int<int>(-20, 20) * 1e100);
+        if (random.draw_bool()) {
+            int64_t seconds = random.draw_int<int64_t>(-2, 2);
+            int32_t nanoseconds = random.draw_int<int32_t>(0, 3);
+            if (seconds < 0 || (seconds == 0 && random.draw_bool()))
+                nanoseconds = -nanoseconds;
+            origin->set_timestamp(5, i, Timestamp(seconds, nanoseconds));
+        }
+        if (random.draw_int_mod(4) != 0)
+            origin->set_link(6, i, random.draw_int_mod(10));
+    }
+
+    // Three-way comparison of rows with nulls first
+    auto compare = [](bool null_a, bool null_b, auto a, auto b) {
+        if (null_a || null_b)
+            return null_a == null_b ? 0 : null_a ? -1 : 1;
+        return a == b ? 0 : a < b ? -1 : 1;
+    };
+    auto check_sorted = [&](const TableView& tv, bool ascending, auto compare_rows) {
+        CHECK_EQUAL(tv.size(), num_rows);
+        for (size_t i = 1; i < tv.size(); ++i) {
+            size_t a = tv.get_source_ndx(i - 1);
+            size_t b = tv.get_source_ndx(i);
+            int c = compare_rows(a, b);
+            CHECK(ascending ? c < 0 || (c == 0 && a < b) : c > 0 || (c == 0 && a < b));
+        }
+    };
+
+    // Sorting a view again makes the new column the primary one and keeps
+    // the previous order for ties, so each sort starts from a fresh view
+    auto sorted = [&](SortDescriptor order) {
+        TableView tv = origin->where().find_all();
+        tv.sort(std::move(order));
+        return tv;
+    };
+
+    for (bool ascending : {true, false}) {
+        check_sorted(sorted(SortDescriptor(*origin, {{0}}, {ascending})), ascending, [&](size_t a, size_t b) {
+            return compare(false, false, origin->get_int(0, a), origin->get_int(0, b));
+        });
+        check_sorted(sorted(SortDescriptor(*origin, {{1}}, {ascending})), ascending, [&](size_t a, size_t b) {
+            return compare(origin->is_null(1, a), origin->is_null(1, b), origin->get_int(1, a), origin->get_int(1, b));
+        });
+        check_sorted(sorted(SortDescriptor(*origin, {{2}}, {ascending})), ascending, [&](size_t a, size_t b) {
+            return compare(false, false, origin->get_bool(2, a), origin->get_bool(2, b));
+        });
+        check_sorted(sorted(SortDescriptor(*origin, {{3}}, {ascending})), ascending, [&](size_t a, size_t b) {
+            return compare(origin->is_null(3, a), origin->is_null(3, b), origin->get_float(3, a),
+                           origin->get_float(3, b));
+        });
+        check_sorted(sorted(SortDescriptor(*origin, {{4}}, {ascending})), ascending, [&](size_t a, size_t b) {
+            return compare(false, false, origin->get_double(4, a), origin->get_double(4, b));
+        });
+        check_sorted(sorted(SortDescriptor(*origin, {{5}}, {ascending})), ascending, [&](size_t a, size_t b) {
+            Timestamp ta = origin->get_timestamp(5, a);
+            Timestamp tb = origin->get_timestamp(5, b);
+            return compare(ta.is_null(), tb.is_null(), ta, tb);
+        });
+
+        // Null links go after all values when ascending
+        check_sorted(sorted(SortDescriptor(*origin, {{6, 0}}, {ascending})), ascending, [&](size_t a, size_t b) {
+            bool null_a = origin->is_null_link(6, a);
+            bool null_b = origin->is_null_link(6, b);
+            if (null_a || null_b)
+                return null_a == null_b ? 0 : null_a ? 1 : -1;
+            return compare(false, false, target->get_int(0, origin->get_link(6, a)),
+                           target->get_int(0, origin->get_link(6, b)));
+        });
+    }
+}
+
+
+TEST(TableView_SortParallel)
+{
+    Random random(random_int<unsigned long>()); // Seed from slow global generator
+
+    Table table;
+    table.add_column(type_Int, "int");
+    table.add_column(type_Timestamp, "timestamp", true);
+    const size_t num_rows = 200000;
+    table.add_empty_row(num_rows);
+    for (size_t i = 0; i < num_rows; ++i) {
+        table.set_int(0, i, random.draw_int<int64_t>(-1000, 1000));
+        if (i % 13 != 0)
+            table.set_timestamp(1, i, Timestamp(random.draw_int<int64_t>(0, 100), random.draw_int<int32_t>(0, 10)));
+    }
+
+    // Sorting on several threads must give the same order, including the
+    // order of ties, as sorting on one
+    size_t budget = get_sort_thread_budget();
+    for (size_t col = 0; col < 2; ++col) {
+        for (bool ascending : {true, false}) {
+            set_sort_thread_budget(1);
+            TableView expected = table.where().find_all();
+            expected.sort(col, ascending);
+            set_sort_thread_budget(4);
+            TableView tv = table.where().find_all();
+            tv.sort(col, ascending);
+            CHECK_EQUAL(tv.size(), num_rows);
+            for (size_t i = 0; i < num_rows; ++i) {
+                if (tv.get_source_ndx(i) != expected.get_source_ndx(i)) {
+                    CHECK_EQUAL(tv.get_source_ndx(i), expected.get_source_ndx(i));
+                    break;
+                }
+            }
+        }
+    }
+    set_sort_thread_budget(budget);
+}
+
+
+TEST(TableView_DistinctKeepsFirstOccurrence)
+{
+    Random random(random_int<unsigned long>()); // Seed from slow global generator
+
+    Group group;
+    TableRef target_ref = group.add_table("target");
+    TableRef origin_ref = group.add_table("origin");
+    Table& target = *target_ref;
+    Table& origin = *origin_ref;
+    target.add_column(type_String, "string", true);
+    target.add_empty_row(10);
+    for (size_t i = 0; i < 10; ++i)
+        target.set_string(0, i, i % 4 == 0 ? StringData() : StringData(i % 2 ? "odd" : "even"));
+
+    origin.add_column(type_Int, "int", true);
+    origin.add_column(type_Double, "double");
+    origin.add_column(type_String, "string");
+    origin.add_column_link(type_Link, "link", target);
+    const size_t num_rows = 2000;
+    origin.add_empty_row(num_rows);
+    const char* strings[] = {"", "a", "b", "abc"};
+    for (size_t i = 0; i < num_rows; ++i) {
+        if (i % 7 != 0)
+            origin.set_int(0, i, random.draw_int<int64_t>(0, 5));
+        origin.set_double(1, i, random.draw_int<int>(0, 2) == 0 ? -0.0 : double(random.draw_int<int>(0, 3)));
+        origin.set_string(2, i, strings[random.draw_int<int>(0, 3)]);
+        if (i % 11 != 0)
+            origin.set_link(3, i, random.draw_int<size_t>(0, 9));
+    }
+
+    // Returns the rows of `tv` in order, omitting those that are equal to an
+    // earlier one according to `same`
+    auto first_occurrences = [](const TableView& tv, std::function<bool(size_t, size_t)> same) {
+        std::vector<size_t> rows;
+        for (size_t i = 0; i < tv.size(); ++i) {
+            size_t row = tv.get_source_ndx(i);
+            if (std::none_of(rows.begin(), rows.end(), [&](size_t r) { return same(r, row); }))
+                rows.push_back(row);
+        }
+        return rows;
+    };
+    auto check_rows = [&](const TableView& tv, const std::vector<size_t>& expected) {
+        CHECK_EQUAL(tv.size(), expected.size());
+        for (size_t i = 0; i < tv.size() && i < expected.size(); ++i)
+            CHECK_EQUAL(tv.get_source_ndx(i), expected[i]);
+    };
+    auto same_int_double_string = [&](size_t a, size_t b) {
+        return origin.is_null(0, a) == origin.is_null(0, b) && origin.get_int(0, a) == origin.get_int(0, b) &&
+               origin.get_double(1, a) == origin.get_double(1, b) && origin.get_string(2, a) == origin.get_string(2, b);
+    };
+
+    // In table order
+    TableView tv = origin.where().find_all();
+    std::vector<size_t> expected = first_occurrences(tv, same_int_double_string);
+    tv.distinct(DistinctDescriptor(origin, {{0}, {1}, {2}}));
+    check_rows(tv, expected);
+
+    // In the order of a previous sort
+    tv = origin.where().find_all();
+    tv.sort(SortDescriptor(origin, {{2}, {0}}, {false, true}));
+    expected = first_occurrences(tv, same_int_double_string);
+    tv.distinct(DistinctDescriptor(origin, {{0}, {1}, {2}}));
+    check_rows(tv, expected);
+
+    // Through a link, where rows with a null link are removed
+    tv = origin.where().find_all();
+    std::vector<size_t> linked;
+    for (size_t row : first_occurrences(tv, [&](size_t a, size_t b) {
+             if (origin.is_null_link(3, a) || origin.is_null_link(3, b))
+                 return origin.is_null_link(3, a) && origin.is_null_link(3, b);
+             return target.get_string(0, origin.get_link(3, a)) == target.get_string(0, origin.get_link(3, b));
+         })) {
+        if (!origin.is_null_link(3, row))
+            linked.push_back(row);
+    }
+    tv.distinct(DistinctDescriptor(origin, {{3, 0}}));
+    check_rows(tv, linked);
+}
+
 #endif // TEST_TABLE_VIEW
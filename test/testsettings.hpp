@@ -57,6 +57,7 @@
 #define TEST_LANG_BIND_HELPER
 #define TEST_METRICS
 #define TEST_QUERY
+#define TEST_QUERY_CACHE
 #define TEST_SHARED
 #define TEST_STRING_DATA
 #define TEST_BINARY_DATA
@@ -67,6 +68,7 @@
 #define TEST_TRANSACTIONS
 #define TEST_TRANSACTIONS_LASSE
 #define TEST_REPLICATION
+#define TEST_ROW_BITMAP
 #define TEST_UTF8
 #define TEST_COLUMN_LARGE
 #define TEST_JSON